@@ -0,0 +1,87 @@
+#include "io/NumericCodec.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <print>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Runs a million values through the same pipeline the arithmetic commands do, reading every value from
+// text, adding one and writing it back out, once with ``std::stringstream`` and once with the codec.
+
+namespace {
+
+constexpr std::size_t NUMBER_OF_VALUES = 1'000'000;
+
+std::vector<std::string> make_values()
+{
+    std::vector<std::string> values {};
+    values.reserve(NUMBER_OF_VALUES);
+
+    for (auto index = 0zu; index != NUMBER_OF_VALUES; index += 1)
+    {
+        // a mix of integral and fractional values, like ``iota`` followed by some arithmetic produces.
+        auto const value = index % 2 == 0 ? static_cast<float>(index) : static_cast<float>(index) / 7.0f;
+        values.push_back(ballin::io::format_real(value));
+    }
+
+    return values;
+}
+
+std::size_t run_stringstream(std::vector<std::string> const& values)
+{
+    auto outputLength = 0zu;
+
+    for (auto const& value : values)
+    {
+        float number {};
+        std::stringstream { value } >> number;
+
+        std::stringstream stream {};
+        stream << (number + 1.0f);
+
+        outputLength += stream.str().size();
+    }
+
+    return outputLength;
+}
+
+std::size_t run_codec(std::vector<std::string> const& values)
+{
+    auto outputLength = 0zu;
+
+    for (auto const& value : values)
+    {
+        auto const number = ballin::io::parse_real(value);
+        outputLength += ballin::io::format_real(number.value_or(0.0f) + 1.0f).size();
+    }
+
+    return outputLength;
+}
+
+template <class Function>
+double measure(Function const& function, std::size_t& result)
+{
+    auto const start = std::chrono::steady_clock::now();
+    result = function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main()
+{
+    auto const values = make_values();
+
+    auto stringstreamLength = 0zu;
+    auto codecLength        = 0zu;
+
+    auto const stringstreamTime = measure([&] { return run_stringstream(values); }, stringstreamLength);
+    auto const codecTime        = measure([&] { return run_codec(values); }, codecLength);
+
+    std::println("{} values, parse, add and format.", NUMBER_OF_VALUES);
+    std::println("stringstream: {:8.2f} ms ({} bytes written).", stringstreamTime, stringstreamLength);
+    std::println("codec:        {:8.2f} ms ({} bytes written).", codecTime, codecLength);
+    std::println("speedup:      {:8.2f}x", stringstreamTime / codecTime);
+}
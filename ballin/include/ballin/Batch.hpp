@@ -0,0 +1,95 @@
+#pragma once
+
+#include "io/Output.hpp"
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <vector>
+
+namespace ballin {
+
+// Fixed-capacity run of values stored in a single contiguous, typed column, which is how values
+// travel between stages that know how to process many of them at once.
+class Batch
+{
+public:
+    static constexpr std::size_t CAPACITY = 1024;
+
+    enum class Type { TEXT, INTEGER, REAL };
+
+    constexpr auto type() const { return type_m; }
+
+    std::size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    // empties the batch and switches it to a column of ``type``, keeping the allocated storage around.
+    void reset(Type const type);
+    // drops every value past the first ``size`` ones.
+    void truncate(std::size_t const size);
+
+    constexpr auto& texts() { return texts_m; }
+    constexpr auto& integers() { return integers_m; }
+    constexpr auto& reals() { return reals_m; }
+    constexpr auto const& texts() const { return texts_m; }
+    constexpr auto const& integers() const { return integers_m; }
+    constexpr auto const& reals() const { return reals_m; }
+
+    std::string text(std::size_t const index) const;
+    // appends the textual form of a value to ``output``, numbers in the shortest form that reads back the same.
+    void append_text(std::size_t const index, std::string& output) const;
+    // a value read as a number, failing the same way the scalar commands do for text that isn't one.
+    std::expected<float, std::string> real(std::size_t const index) const;
+    std::expected<std::size_t, std::string> integer(std::size_t const index) const;
+
+private:
+    Type type_m { Type::TEXT };
+    std::vector<std::string> texts_m {};
+    std::vector<std::size_t> integers_m {};
+    std::vector<float> reals_m {};
+};
+
+// writes ``operation(value)`` for every value of ``input`` read as a float into a column of reals. text
+// that isn't a number is reported and left out, as running the command on it alone would.
+template <class Operation>
+void transform_reals(Batch const& input, Batch& output, Operation operation)
+{
+    output.reset(Batch::Type::REAL);
+
+    auto& results = output.reals();
+    results.resize(input.size());
+
+    switch (input.type())
+    {
+    case Batch::Type::INTEGER: {
+        auto const& values = input.integers();
+        for (auto index = 0zu; index != values.size(); index += 1) { results[index] = operation(static_cast<float>(values[index])); }
+        break;
+    }
+    case Batch::Type::REAL: {
+        auto const& values = input.reals();
+        for (auto index = 0zu; index != values.size(); index += 1) { results[index] = operation(values[index]); }
+        break;
+    }
+    case Batch::Type::TEXT: {
+        results.clear();
+
+        for (auto index = 0zu; index != input.size(); index += 1)
+        {
+            auto const value = input.real(index);
+
+            if (!value.has_value())
+            {
+                io::println("{}", value.error());
+                continue;
+            }
+
+            results.push_back(operation(value.value()));
+        }
+
+        break;
+    }
+    }
+}
+
+}
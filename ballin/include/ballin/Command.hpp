@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Batch.hpp"
+#include "Stream.hpp"
+#include "math/Program.hpp"
+
+#include <deque>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ballin {
+
+class Command
+{
+public:
+    // polymorphic, so that the lists passed around while a line runs can come out of its scratch
+    // memory, see ``memory::line_resource``.
+    using arguments_t        = std::pmr::deque<std::string>;
+    using return_t           = std::pmr::deque<std::string>;
+    using signature_t        = std::function<return_t(arguments_t)>;
+    // streaming commands receive the output of the previous stage as a lazy stream, rather than
+    // appended to their arguments, and hand back a lazy stream of their own.
+    using stream_signature_t = std::function<Stream(arguments_t, Stream)>;
+    // batch kernels run the command once per value of ``input``, the value being the first argument
+    // and ``arguments`` the rest, writing the results to ``output`` in the same order.
+    using batch_kernel_t     = std::function<void(arguments_t const& arguments, Batch const& input, Batch& output)>;
+    // commands that amount to an arithmetic expression over their first argument describe it as a
+    // program, given the rest of their arguments, so that chains of them can be fused into one stage.
+    using program_t          = std::function<std::optional<math::Program>(arguments_t const& arguments)>;
+
+    // what running the command does besides producing values, which decides what may run alongside it.
+    enum class Effect
+    {
+        PURE,
+        // writes to the output, which is fine to capture and write out later.
+        OUTPUT,
+        // touches state that other lines may depend on, so it has to run on its own.
+        BARRIER,
+        // whatever the command named by its first argument does, as for ``apply``.
+        OF_TARGET
+    };
+
+    Command() = default;
+
+    Command(std::string_view const commandName, std::size_t const numberOfArguments, signature_t const commandAction):
+        name_m(commandName),
+        expectedNumberOfArguments_m(numberOfArguments),
+        action_m(commandAction)
+    {}
+
+    Command(std::string_view const commandName, std::size_t const numberOfArguments, signature_t const commandAction, batch_kernel_t const commandBatchKernel, program_t const commandProgram = {}):
+        name_m(commandName),
+        expectedNumberOfArguments_m(numberOfArguments),
+        action_m(commandAction),
+        batchKernel_m(commandBatchKernel),
+        program_m(commandProgram)
+    {}
+
+    Command(std::string_view const commandName, std::size_t const numberOfArguments, stream_signature_t const commandStreamAction, program_t const commandProgram = {}):
+        name_m(commandName),
+        expectedNumberOfArguments_m(numberOfArguments),
+        streamAction_m(commandStreamAction),
+        program_m(commandProgram)
+    {}
+
+    constexpr auto const& arguments_stack() const { return argumentsStack_m; }
+    constexpr auto const& name() const { return name_m; }
+    constexpr auto const& expected_number_of_arguments() const { return expectedNumberOfArguments_m; }
+    constexpr auto& subcommands() const { return subcommands_m; }
+    constexpr auto& subcommands() { return subcommands_m; }
+    auto is_streaming() const { return static_cast<bool>(streamAction_m); }
+    constexpr auto const& batch_kernel() const { return batchKernel_m; }
+    constexpr auto effect() const { return effect_m; }
+
+    // the program this command runs per value of its input as a stage, with its current arguments, if it
+    // has one. only streaming commands have one, the rest only describe what they do to a single value.
+    std::optional<math::Program> program() const;
+    // the program the command runs per value given the rest of its arguments, for ``apply`` to use.
+    std::optional<math::Program> program(arguments_t const& arguments) const;
+
+    constexpr Command& with_effect(Effect const commandEffect) { effect_m = commandEffect; return *this; }
+
+    auto push_back_argument(std::string_view const argument) { argumentsStack_m.emplace_back(argument); }
+    auto push_front_argument(std::string_view const argument) { argumentsStack_m.emplace_front(argument); }
+    auto clear_arguments() { argumentsStack_m.clear(); }
+    auto push_subcommand(Command&& subcommand) { subcommands_m.push_back(std::move(subcommand)); }
+
+    return_t operator()() const;
+    return_t operator()(arguments_t argumentsStack) const;
+
+    // commands without a streaming action drain ``input`` and run eagerly.
+    Stream stream(Stream input) const;
+
+private:
+    std::string name_m {};
+    arguments_t argumentsStack_m {};
+    std::size_t expectedNumberOfArguments_m {};
+    signature_t action_m {};
+    stream_signature_t streamAction_m {};
+    batch_kernel_t batchKernel_m {};
+    program_t program_m {};
+    Effect effect_m { Effect::PURE };
+    std::vector<Command> subcommands_m {};
+};
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Command.hpp"
+#include "Tokenizer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ballin {
+
+// Pipelines parsed from earlier lines. A line seen before is reused as is, and a line that only
+// differs from an earlier one in its arguments reuses the commands looked up for it and just has its
+// arguments rebound. Everything is forgotten whenever the registered commands change.
+class CommandCache
+{
+public:
+    static constexpr std::size_t CAPACITY = 1024;
+
+    struct Statistics
+    {
+        std::size_t lineHits;
+        std::size_t templateHits;
+        std::size_t misses;
+    };
+
+    // drops every pipeline parsed against a different version of the registry.
+    void synchronize(std::size_t const version);
+
+    std::shared_ptr<Command const> find(std::string_view const line);
+    // ``tokens`` being the tokens of ``line``, which is cached from now on if there's a match.
+    std::shared_ptr<Command const> find_template(std::string_view const line, std::span<Tokenizer::Token const> tokens);
+    void insert(std::string_view const line, std::span<Tokenizer::Token const> tokens, std::shared_ptr<Command const> command);
+
+    // safe to call while the cache is being used from another thread.
+    Statistics statistics() const;
+
+private:
+    struct Hash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view const value) const { return std::hash<std::string_view> {}(value); }
+    };
+
+    using map_t = std::unordered_map<std::string, std::shared_ptr<Command const>, Hash, std::equal_to<>>;
+
+    // the names of the commands of a pipeline along with how many arguments each was given.
+    std::string_view template_of(std::span<Tokenizer::Token const> tokens);
+
+    std::size_t version_m {};
+    map_t lines_m {};
+    map_t templates_m {};
+    std::string template_m {};
+    std::atomic<std::size_t> lineHits_m {};
+    std::atomic<std::size_t> templateHits_m {};
+    std::atomic<std::size_t> misses_m {};
+};
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Command.hpp"
+#include "suggest/BKTree.hpp"
+#include "suggest/PrefixTrie.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ballin {
+
+// Read-mostly command registry. Lookups go through an immutable snapshot that is swapped atomically,
+// so any number of interpreters may resolve commands concurrently without taking a lock. Registrations
+// copy the current snapshot, modify the copy and publish it; writers are serialized among themselves.
+class Commands
+{
+public:
+    struct Snapshot
+    {
+        std::unordered_map<std::string, Command> commands;
+        suggest::BKTree suggestions;
+        suggest::PrefixTrie completions;
+        std::size_t version;
+    };
+
+    Commands();
+
+    std::shared_ptr<Snapshot const> snapshot() const { return snapshot_m.load(std::memory_order_acquire); }
+    std::size_t version() const { return snapshot()->version; }
+
+    bool contains(std::string_view const commandName) const;
+    std::optional<Command> command(std::string_view const commandName) const;
+    std::vector<std::string> completions(std::string_view const prefix) const;
+
+    void register_command(Command command);
+    // publishes every command in a single snapshot, instead of one per command.
+    void register_commands(std::vector<Command> commands);
+    // removes ``removedCommandNames`` and registers ``commands`` in a single snapshot.
+    void replace_commands(std::vector<std::string> const& removedCommandNames, std::vector<Command> commands);
+
+private:
+    std::atomic<std::shared_ptr<Snapshot const>> snapshot_m;
+    std::mutex writerMutex_m {};
+};
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Command.hpp"
+#include "Commands.hpp"
+#include "Parser.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ballin {
+
+class Interpreter
+{
+public:
+    enum class ExecutionMode
+    {
+        // every stage of a pipeline runs on the calling thread, pulled by the stage after it.
+        SEQUENTIAL,
+        // every stage runs on a thread of its own, handing batches to the next one through a bounded ring.
+        PIPELINED
+    };
+
+    explicit Interpreter(Commands const& commands);
+
+    constexpr auto execution_mode() const { return executionMode_m; }
+    constexpr void set_execution_mode(ExecutionMode const executionMode) { executionMode_m = executionMode; }
+
+    // a line starting with ``explain`` prints the stages its pipeline would run as, instead of running it.
+    // lines are parsed once, repeating one (or one that only differs in arguments) reuses its pipeline.
+    // ``< file`` feeds the numbers in a file to the first stage, ``> file`` and ``>> file`` send what
+    // the line prints to a file, and a line with nothing else copies its input file over as it is.
+    void enqueue_command(std::string_view input);
+    void enqueue_command(Parser::Line const& line);
+
+    // parses ``input``, reporting whatever is wrong with it.
+    Parser::Line parse_command(std::string_view input);
+    // parses ``input`` without reporting anything, so that lines can be parsed ahead on a thread other
+    // than the one running them. it must not be called from more than one thread at a time.
+    Parser::Line prepare_command(std::string_view input);
+    Parser::Line prepare_command(TokenizedLine const& line);
+    // whether the registry changed since ``line`` was prepared, say by a ``reload`` run in the meantime,
+    // in which case it has to be parsed again to pick up the commands as they are now.
+    bool is_stale(Parser::Line const& line) const;
+
+    // completes the word being typed at the end of ``input``, as long as it sits where a command
+    // name is expected: the start of the line, right after a ``|`` or as the target of ``apply``.
+    std::vector<std::string> complete(std::string_view input) const;
+
+    void execute();
+
+    // what running ``line`` would do besides producing values, see ``Command::Effect``.
+    Command::Effect effect_of(Parser::Line const& line) const;
+    // runs ``line`` right away, regardless of what is queued. unlike the rest of the interpreter it is
+    // safe to call from several threads at once, as long as the lines only ever touch the output.
+    void run(Parser::Line const& line) const;
+
+    CommandCache::Statistics cache_statistics() const;
+
+private:
+    // scratch memory of a line, handed back in one go once the line has run. it holds the plan of the
+    // line and, through ``memory::LineArena``, the argument and result lists its commands pass around.
+    static constexpr std::size_t ARENA_SIZE = 64 * 1024;
+    // output sent to a file goes out in writes of this size.
+    static constexpr std::size_t OUTPUT_FILE_BUFFER_SIZE = 1 << 20;
+
+    struct Stage
+    {
+        // either one of the commands of the pipeline or the one running a run of them fused together.
+        Command const* command;
+        std::size_t numberOfCommands;
+    };
+
+    struct Plan
+    {
+        explicit Plan(std::pmr::memory_resource* resource):
+            commands(resource),
+            fusedCommands(resource),
+            stages(resource)
+        {}
+
+        std::pmr::vector<Command const*> commands;
+        std::pmr::vector<Command> fusedCommands;
+        std::pmr::vector<Stage> stages;
+    };
+
+    // turns a pipeline into the stages it runs as, fusing runs of consecutive stages that describe
+    // themselves as programs into a single stage that evaluates all of them in one pass per value.
+    Plan plan(Command const& masterCommand, std::pmr::memory_resource* resource) const;
+
+    // sets up the redirections of ``line`` around running it.
+    void run_line(Parser::Line const& line, std::pmr::memory_resource* resource) const;
+    void explain(Command const& masterCommand, std::pmr::memory_resource* resource) const;
+    void run_command(Command const& masterCommand, Stream input, std::pmr::memory_resource* resource) const;
+    void execute_pipelined(Plan const& plannedCommand, Stream input) const;
+
+    ExecutionMode executionMode_m { ExecutionMode::SEQUENTIAL };
+    std::queue<Parser::Line> queuedCommands_m {};
+    Commands const& commands_m;
+    Parser parser_m;
+    Parser preparer_m;
+    std::array<std::byte, ARENA_SIZE> arenaBuffer_m;
+    std::pmr::monotonic_buffer_resource arena_m { arenaBuffer_m.data(), arenaBuffer_m.size() };
+};
+
+}
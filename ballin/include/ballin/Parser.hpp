@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Command.hpp"
+#include "CommandCache.hpp"
+#include "Commands.hpp"
+#include "Tokenizer.hpp"
+
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ballin {
+
+// Turns lines into the pipelines they describe, reusing the ones parsed from earlier lines. A parser
+// isn't meant to be shared between threads, but separate parsers over the same registry are fine.
+class Parser
+{
+public:
+    // files given with ``< file``, ``> file`` and ``>> file`` anywhere on the line.
+    struct Redirections
+    {
+        // read as whitespace separated values, which the first stage receives as its input.
+        std::optional<std::string> input;
+        // receives everything the line prints instead of the standard output.
+        std::optional<std::string> output;
+        // whether the output is added to the end of the file rather than replacing it.
+        bool append;
+    };
+
+    struct Line
+    {
+        enum class Type
+        {
+            // nothing to be done, either an empty line or one whose error was already reported.
+            NOTHING,
+            PIPELINE,
+            // the pipeline is to be described rather than run.
+            EXPLAIN,
+            // the line has an error that wasn't reported, parse it again with ``reportErrors`` to do that.
+            UNPARSED,
+            // the line is nothing but redirections, the input file is written out as it is.
+            COPY
+        };
+
+        Type type;
+        std::shared_ptr<Command const> command;
+        Redirections redirections {};
+        // the version of the registry the line was prepared against, see ``Interpreter::prepare_command``.
+        std::size_t version {};
+    };
+
+    explicit Parser(Commands const& commands);
+
+    Line parse(std::string_view const input, bool const reportErrors);
+    // same as above, for a line that was tokenized already.
+    Line parse(TokenizedLine const& line, bool const reportErrors);
+
+    auto statistics() const { return commandCache_m.statistics(); }
+
+private:
+    Line parse_tokens(std::string_view const input, std::expected<std::span<Tokenizer::Token const>, std::string> const& maybeTokens, bool const reportErrors);
+    std::optional<Command> parse_command(std::span<Tokenizer::Token const> tokens, bool const reportErrors) const;
+    // takes the redirections out of ``tokens``, leaving the rest in ``commandTokens_m``.
+    bool take_redirections(std::span<Tokenizer::Token const> tokens, Redirections& redirections, bool const reportErrors);
+
+    Commands const& commands_m;
+    Tokenizer tokenizer_m {};
+    std::vector<Tokenizer::Token> commandTokens_m {};
+    CommandCache commandCache_m {};
+};
+
+}
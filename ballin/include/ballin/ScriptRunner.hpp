@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Interpreter.hpp"
+#include "Parser.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ballin {
+
+// Runs the lines of a script with as many of them at once as they allow. Lines that only produce
+// values or write to the output don't depend on each other, so they run side by side on the scheduler,
+// each capturing its output to have it written out in the order of the lines. Lines with any other
+// effect wait for every line before them to be done and hold back every line after them.
+//
+// The script is taken a window of lines at a time, which bounds how much output is held back.
+class ScriptRunner
+{
+public:
+    static constexpr std::size_t WINDOW_SIZE = 1024;
+
+    // hands out the next line of the script, which only has to stay valid until the next call.
+    using read_line_t = std::move_only_function<std::optional<std::string_view>()>;
+
+    explicit ScriptRunner(Interpreter& interpreter);
+
+    void run(read_line_t readLine);
+
+private:
+    void prepare_line(std::size_t const index);
+    // runs the lines in [begin, end) side by side and writes their output out in order.
+    void run_lines(std::size_t const begin, std::size_t const end);
+
+    Interpreter& interpreter_m;
+    std::vector<std::string> lines_m {};
+    std::vector<Parser::Line> preparedLines_m {};
+    std::vector<std::string> outputs_m {};
+};
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Batch.hpp"
+
+#include <deque>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <string>
+
+namespace ballin {
+
+// Pull-based sequence of values flowing between the stages of a pipeline. Values are only computed
+// when the consumer asks for the next one, so a pipeline runs in constant memory as long as all of its
+// stages stream.
+//
+// A producer may hand out values one at a time or a whole batch at a time; consumers can pull either
+// way regardless of how the stream is produced.
+class Stream
+{
+public:
+    using value_t      = std::string;
+    using values_t     = std::pmr::deque<value_t>;
+    using pull_t       = std::move_only_function<std::optional<value_t>()>;
+    // fills the (empty) batch it is given, returns false once there is nothing left to produce.
+    using batch_pull_t = std::move_only_function<bool(Batch&)>;
+
+    Stream() = default;
+    explicit Stream(pull_t pull);
+    explicit Stream(batch_pull_t pullBatch);
+
+    static Stream from(values_t values);
+    static Stream concat(Stream first, Stream second);
+
+    // returns std::nullopt once the stream is exhausted.
+    std::optional<value_t> next();
+    // returns false once the stream is exhausted, otherwise ``batch`` holds at least one value.
+    bool next_batch(Batch& batch);
+    // the values left, in the scratch memory of the line running on the calling thread.
+    values_t collect();
+
+private:
+    pull_t pull_m {};
+    batch_pull_t pullBatch_m {};
+    Batch pending_m {};
+    std::size_t pendingIndex_m {};
+};
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ballin {
+
+// Splits a command line into words, pipes and redirections in a single pass. Words are separated by
+// any run of blanks, ``|``, ``<``, ``>`` and ``>>`` need no blanks around them, and ``"..."``,
+// ``'...'`` and ``\`` quote the way a shell does: double quotes honour backslash escapes, single
+// quotes take everything literally.
+//
+// Words are views into the line itself; only the ones that had quotes or escapes removed from them
+// live in a buffer of the tokenizer instead, which is reused from one line to the next.
+class Tokenizer
+{
+public:
+    struct Token
+    {
+        enum class Type { WORD, PIPE, REDIRECT_INPUT, REDIRECT_OUTPUT, APPEND_OUTPUT };
+
+        Type type;
+        std::string_view text;
+    };
+
+    // the tokens are valid until the next call, as long as ``input`` is.
+    std::expected<std::span<Token const>, std::string> tokenize(std::string_view const input);
+
+private:
+    friend class TokenizedLine;
+
+    std::vector<Token> tokens_m {};
+    std::string unquoted_m {};
+};
+
+// A line tokenized ahead of being parsed, possibly on another thread. It owns the text its tokens view,
+// which doesn't move along with it, so the tokens stay valid however many times the line is moved.
+class TokenizedLine
+{
+public:
+    // an empty line, to be assigned one tokenized for real.
+    TokenizedLine() = default;
+    TokenizedLine(Tokenizer& tokenizer, std::string_view const input);
+
+    constexpr std::string_view text() const { return { storage_m.get(), size_m }; }
+    std::expected<std::span<Tokenizer::Token const>, std::string> tokens() const;
+
+private:
+    // the line itself followed by whatever words the tokenizer had to unquote.
+    std::unique_ptr<char[]> storage_m {};
+    std::size_t size_m { 0 };
+    std::vector<Tokenizer::Token> tokens_m {};
+    std::string error_m {};
+};
+
+}
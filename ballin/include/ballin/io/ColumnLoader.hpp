@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Stream.hpp"
+
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ballin::io {
+
+// Streams the values of a file of comma or whitespace separated columns, one line per row. The file is
+// mapped rather than read, cut into chunks at line boundaries and the chunks of a round are parsed on
+// the scheduler's workers, each into typed batches of its own that are handed out in file order.
+//
+// Files whose first line has a comma in it are read as CSV, anything else as whitespace separated.
+// ``column`` is either counted from 1 or the name it has in the first line, which is then skipped. A
+// column given by number skips the first line too when it isn't a number there, taking it for a header.
+// Without one, every field is streamed row after row. Rows missing a value, be it in the column or,
+// without one, in any field, are left out and reported rather than shifting the values after them.
+std::expected<Stream, std::string> load_columns(std::filesystem::path const& path, std::optional<std::string_view> const column);
+
+}
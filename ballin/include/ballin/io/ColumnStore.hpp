@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Stream.hpp"
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace ballin::io {
+
+// Named columns of numbers kept on disk from one session to the next, each in a file of its own in the
+// working directory: a small header followed by every value at a fixed width, integers as 64 bit ones
+// and everything else as floats, in the byte order of the machine that wrote them. Reading a column
+// back only maps the file, the values are never parsed.
+
+// the file the column named ``name`` is kept in.
+std::filesystem::path column_path(std::string_view const name);
+
+// writes every value of ``values`` into the column named ``name``, replacing whatever it held. the column
+// holds integers as long as every value is one, and a value that isn't a number fails the whole store,
+// leaving the column as it was. returns how many values were stored.
+std::expected<std::size_t, std::string> store_column(std::string_view const name, Stream values);
+// the values of the column named ``name``, read straight off its mapping.
+std::expected<Stream, std::string> fetch_column(std::string_view const name);
+
+}
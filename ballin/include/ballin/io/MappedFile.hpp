@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace ballin::io {
+
+// Read-only view of a whole file, mapped into memory rather than read into a buffer of our own. The
+// view stays valid for as long as the mapping is alive.
+class MappedFile
+{
+public:
+    static std::expected<MappedFile, std::string> open(std::filesystem::path const& path);
+    // maps the file behind ``descriptor``, which has to be a regular file. the descriptor isn't closed.
+    static std::expected<MappedFile, std::string> open(int const descriptor);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    std::string_view contents() const { return { static_cast<char const*>(data_m), size_m }; }
+
+private:
+    MappedFile(void* data, std::size_t const size);
+
+    void* data_m {};
+    std::size_t size_m {};
+};
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Batch.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace ballin::io {
+
+// Bulk reading of whitespace separated numbers, for when a whole text full of them comes in at once.
+// Separators are found a 16 byte block at a time (with SSE2 where it's available) and the fields are
+// then read together into a single typed column: integers while every field in the batch is one,
+// reals otherwise, and the fields as they are when some aren't numbers at all.
+
+// fills ``batch`` with up to ``Batch::CAPACITY`` values read from ``text`` starting at ``position``, and
+// moves ``position`` past them. returns false once there is nothing left but whitespace.
+bool scan_numbers(std::string_view const text, std::size_t& position, Batch& batch);
+// reads fields that were already split apart into ``batch``, typed the same way.
+void read_numbers(std::span<std::string_view const> fields, Batch& batch);
+
+}
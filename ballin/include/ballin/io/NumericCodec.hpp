@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+
+namespace ballin::io {
+
+// Conversions between numbers and their textual form, shared by every command. They don't depend on
+// the locale, don't allocate unless asked for a string and say why a text couldn't be read instead of
+// quietly reading it as zero.
+
+// longest text the formatters write, a 64 bit integer in binary.
+constexpr std::size_t MAXIMUM_NUMBER_LENGTH = 64;
+
+// the whole of ``text`` has to be the number, an optional leading ``+`` aside.
+std::expected<float, std::string> parse_real(std::string_view const text);
+std::expected<std::size_t, std::string> parse_integer(std::string_view const text);
+
+// writes the shortest digits that read back as the same float, in full unless the number is too large
+// or too small for that to stay readable. returns one past the last character written.
+char* format_real(char* const first, char* const last, float const value);
+char* format_integer(char* const first, char* const last, std::size_t const value, int const base = 10);
+
+void append_real(std::string& output, float const value);
+void append_integer(std::string& output, std::size_t const value, int const base = 10);
+
+std::string format_real(float const value);
+std::string format_integer(std::size_t const value, int const base = 10);
+
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace ballin::io {
+
+// Buffered writer in front of a file descriptor. Writes are gathered in a large buffer and handed to
+// the kernel in as few calls as possible: once the buffer fills up, at the flush points the flush
+// policy asks for, and when the sink goes away. Writes too large for the buffer go out together with
+// whatever is buffered in a single ``writev``, without being copied.
+class Sink
+{
+public:
+    enum class FlushPolicy
+    {
+        // at the end of every line the interpreter runs, for interactive sessions.
+        LINE,
+        // only when the buffer is full, for scripts and anything else no one is watching as it runs.
+        FULL
+    };
+
+    struct Options
+    {
+        std::size_t bufferSize;
+        FlushPolicy flushPolicy;
+    };
+
+    Sink(int const descriptor, Options const& options);
+    ~Sink();
+
+    // opens ``path`` for writing, emptying it first unless ``append`` is set. the sink closes it when it goes away.
+    static std::expected<std::unique_ptr<Sink>, std::string> open(std::filesystem::path const& path, bool const append, Options const& options);
+
+    Sink(Sink const&) = delete;
+    Sink& operator=(Sink const&) = delete;
+
+    // the sink in front of stdout, created with the options of the last ``configure`` on first use.
+    static Sink& standard_output();
+    static void configure(Options const& options);
+    static Options default_options();
+
+    void write(std::string_view const text);
+
+    template <class... Arguments>
+    void print(std::format_string<Arguments...> format, Arguments&&... arguments)
+    {
+        std::scoped_lock const lock { mutex_m };
+        std::format_to(std::back_inserter(buffer_m), format, std::forward<Arguments>(arguments)...);
+        if (buffer_m.size() >= options_m.bufferSize) { flush_locked(); }
+    }
+
+    void flush();
+    // flush point at the end of every line the interpreter runs.
+    void end_line();
+
+    // writes out the rest of the file behind ``descriptor``. the kernel copies it over when both ends are
+    // files, otherwise it's mapped and written straight from the mapping.
+    void write_file(int const descriptor);
+
+private:
+    void flush_locked(std::string_view const text = {});
+
+    int descriptor_m {};
+    bool ownsDescriptor_m {};
+    Options options_m {};
+    std::mutex mutex_m {};
+    std::string buffer_m {};
+};
+
+// Where everything commands print ends up. Output goes to the standard output sink unless the calling
+// thread is capturing it, in which case it is appended to a string to be written out later; that is
+// how lines that run at the same time still have their output come out in order. A thread may also
+// be redirected to a sink of its own, which is how lines send their output to a file. Threads doing
+// part of the work of another one adopt its destination, so that their output ends up in the same place.
+
+class Capture;
+
+struct Destination
+{
+    Capture* capture;
+    Sink* sink;
+};
+
+// where the calling thread's output goes, to be handed to the threads that work on its behalf.
+Destination current_destination();
+// the capture the calling thread writes into, if any.
+Capture* current_capture();
+// the sink the calling thread writes to when it isn't capturing.
+Sink& current_sink();
+
+// while alive, whatever the current thread prints is appended to ``target`` instead. threads that adopt
+// the destination append to it as well, which is why appending takes a lock.
+class Capture
+{
+public:
+    explicit Capture(std::string& target);
+    ~Capture();
+
+    Capture(Capture const&) = delete;
+    Capture& operator=(Capture const&) = delete;
+
+    void write(std::string_view const text);
+
+    template <class... Arguments>
+    void print(std::format_string<Arguments...> format, Arguments&&... arguments)
+    {
+        std::scoped_lock const lock { mutex_m };
+        std::format_to(std::back_inserter(*target_m), format, std::forward<Arguments>(arguments)...);
+    }
+
+private:
+    std::mutex mutex_m {};
+    std::string* target_m {};
+    Destination previousDestination_m {};
+};
+
+// while alive, whatever the current thread prints goes to ``sink``, whether it was capturing or not.
+class Redirect
+{
+public:
+    explicit Redirect(Sink& sink);
+    ~Redirect();
+
+    Redirect(Redirect const&) = delete;
+    Redirect& operator=(Redirect const&) = delete;
+
+private:
+    Destination previousDestination_m {};
+};
+
+// while alive, the current thread writes wherever ``destination`` says.
+class Adopt
+{
+public:
+    explicit Adopt(Destination const& destination);
+    ~Adopt();
+
+    Adopt(Adopt const&) = delete;
+    Adopt& operator=(Adopt const&) = delete;
+
+private:
+    Destination previousDestination_m {};
+};
+
+void write(std::string_view const text);
+void write_file(int const descriptor);
+
+template <class... Arguments>
+void print(std::format_string<Arguments...> format, Arguments&&... arguments)
+{
+    if (auto* const capture = current_capture())
+    {
+        capture->print(format, std::forward<Arguments>(arguments)...);
+        return;
+    }
+
+    current_sink().print(format, std::forward<Arguments>(arguments)...);
+}
+
+template <class... Arguments>
+void println(std::format_string<Arguments...> format, Arguments&&... arguments)
+{
+    // qualified, so that argument dependent lookup doesn't pick ``std::print`` instead.
+    io::print(format, std::forward<Arguments>(arguments)...);
+    io::write("\n");
+}
+
+}
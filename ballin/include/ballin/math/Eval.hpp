@@ -2,10 +2,18 @@
 
 #include "Lexer.hpp"
 
+#include <expected>
+#include <span>
+#include <string>
+
 namespace ballin::math {
 
 std::vector<Token> parse_expression(std::vector<Token> const& tokens);
-float evaluate_expression(std::vector<Token> const& tokens);
+// fails on numbers that don't read as one and on expressions that don't add up to a single value.
+std::expected<float, std::string> evaluate_expression(std::vector<Token> const& tokens);
+// evaluates the expression once per value of ``variables``, each standing in for the VARIABLE token.
+// a malformed expression is reported and leaves ``results`` untouched, returning false.
+bool evaluate_expression(std::vector<Token> const& tokens, std::span<float const> variables, std::span<float> results);
 
 }
 
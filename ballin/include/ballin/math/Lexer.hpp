@@ -11,7 +11,7 @@ struct Token
 {
     enum class Type
     {
-        NUMBER, OPERATOR, LPAREN, RPAREN
+        NUMBER, VARIABLE, OPERATOR, LPAREN, RPAREN
     };
 
     enum class Precedence { NONE, _3, _2, _1 };
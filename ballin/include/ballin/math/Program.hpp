@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Lexer.hpp"
+
+#include <array>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ballin::math {
+
+// Postfix expression over a single variable, decoded into a flat list of instructions so it can be
+// evaluated for many values without touching the tokens again. Programs can be chained one after
+// another, the result of the first becoming the variable of the next, which is how a chain of
+// arithmetic stages turns into a single pass over the values.
+class Program
+{
+public:
+    struct Instruction
+    {
+        enum class Type
+        {
+            NUMBER, VARIABLE, OPERATOR,
+            // pops the top of the stack into the variable, see ``then``.
+            STORE_VARIABLE
+        };
+
+        Type type;
+        char operation;
+        float number;
+    };
+
+    static constexpr std::size_t MAXIMUM_STACK_DEPTH = 64;
+
+    // ``tokens`` in postfix order, as returned by ``parse_expression``.
+    static std::optional<Program> compile(std::vector<Token> const& tokens);
+    // ``variable <operation> operand``, where operation is one of ``+-*/^``.
+    static Program binary(char const operation, float const operand);
+
+    // feeds the result of this program as the variable of ``next``.
+    Program& then(Program const& next);
+
+    float evaluate(float variable) const;
+    void evaluate(std::span<float const> variables, std::span<float> results) const;
+
+    constexpr auto const& instructions() const { return instructions_m; }
+
+private:
+    bool push(Instruction const instruction);
+
+    std::vector<Instruction> instructions_m {};
+    std::size_t stackDepth_m {};
+    std::size_t maximumStackDepth_m {};
+};
+
+}
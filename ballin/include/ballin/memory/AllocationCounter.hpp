@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ballin::memory {
+
+// number of times the global ``operator new`` has been called so far, from any thread. meant to be
+// sampled before and after a piece of work to see how many heap allocations it made.
+std::size_t allocation_count();
+
+}
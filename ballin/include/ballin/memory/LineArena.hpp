@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory_resource>
+
+namespace ballin::memory {
+
+// Scratch memory of the line running on the calling thread, for the argument and result lists its
+// commands pass around. Lists given back are reused by the ones made after them, and whatever the line
+// took is handed back in one go once it is done, so a line running over and over settles into not
+// touching the heap for them at all.
+//
+// Only lists that live and die within a single call on the thread that made them may come from it, it
+// isn't meant to be shared between threads nor to outlive the line.
+
+// the scratch memory of the line running on the calling thread, or the heap when there is none.
+std::pmr::memory_resource* line_resource();
+
+// while alive, the current thread takes its scratch memory out of ``upstream``.
+class LineArena
+{
+public:
+    explicit LineArena(std::pmr::memory_resource* upstream);
+    ~LineArena();
+
+    LineArena(LineArena const&) = delete;
+    LineArena& operator=(LineArena const&) = delete;
+
+private:
+    std::pmr::unsynchronized_pool_resource pool_m;
+    std::pmr::memory_resource* previousResource_m {};
+};
+
+}
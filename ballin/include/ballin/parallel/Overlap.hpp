@@ -0,0 +1,62 @@
+#pragma once
+
+#include "parallel/SpscRing.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace ballin::parallel {
+
+constexpr std::size_t OVERLAP_RING_CAPACITY = 256;
+
+// Runs every item ``read`` hands out through ``prepare`` and then ``run``, with reading and preparing
+// each on a thread of their own working ahead of the calling thread, which runs the items in the order
+// they were read. The threads are bounded by how far ahead they may get, the rings between them
+// holding at most ``capacity`` items each.
+//
+// ``read`` returns std::nullopt once there are no items left, ``prepare`` is called with each item
+// and ``run`` with each item along with what ``prepare`` made of it. items are moved after being
+// prepared, so what ``prepare`` returns mustn't point into them.
+template <class Read, class Prepare, class Run>
+void overlap(Read read, Prepare prepare, Run run, std::size_t const capacity = OVERLAP_RING_CAPACITY)
+{
+    using item_t     = typename std::invoke_result_t<Read&>::value_type;
+    using prepared_t = std::invoke_result_t<Prepare&, item_t const&>;
+
+    SpscRing<item_t> readItems { capacity };
+    SpscRing<std::pair<item_t, prepared_t>> preparedItems { capacity };
+
+    // declared after the rings, so that both threads are joined before the rings go away.
+    std::jthread reader { [&] {
+        while (auto item = read())
+        {
+            if (!readItems.push(item.value())) { break; }
+        }
+
+        readItems.close();
+    }};
+
+    std::jthread preparer { [&] {
+        while (auto item = readItems.pop())
+        {
+            auto prepared     = prepare(std::as_const(item.value()));
+            auto preparedItem = std::pair { std::move(item.value()), std::move(prepared) };
+
+            if (!preparedItems.push(preparedItem)) { break; }
+        }
+
+        // in case it stopped early, the reader mustn't wait on it forever.
+        readItems.close();
+        preparedItems.close();
+    }};
+
+    while (auto preparedItem = preparedItems.pop())
+    {
+        run(preparedItem.value().first, preparedItem.value().second);
+    }
+}
+
+}
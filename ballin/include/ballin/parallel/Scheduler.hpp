@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ballin::parallel {
+
+// Work-stealing thread pool shared by everything in ballin that runs in parallel, so that parallel
+// features compose instead of each spawning threads of its own.
+//
+// Every worker owns a deque: tasks it spawns go to its back and are taken from there, LIFO, while idle
+// workers steal from the front of the others. Workers with nothing to do park until new work arrives.
+class Scheduler
+{
+public:
+    using task_t = std::move_only_function<void()>;
+
+    struct Options
+    {
+        std::size_t numberOfWorkers;
+        bool pinWorkers;
+    };
+
+    explicit Scheduler(Options const& options);
+    ~Scheduler();
+
+    Scheduler(Scheduler const&) = delete;
+    Scheduler& operator=(Scheduler const&) = delete;
+
+    // the scheduler used by default, created with the options of the last ``configure`` on first use.
+    static Scheduler& global();
+    static void configure(Options const& options);
+    static Options default_options();
+
+    constexpr auto number_of_workers() const { return workers_m.size(); }
+
+    void submit(task_t task);
+    // runs one pending task on the calling thread, if there is any. returns whether it did.
+    bool run_pending_task();
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<task_t> tasks;
+    };
+
+    std::optional<task_t> take_task(std::size_t const workerIndex);
+    void work(std::stop_token const stopToken, std::size_t const workerIndex);
+
+    std::vector<std::unique_ptr<Worker>> workers_m {};
+    std::atomic<std::size_t> numberOfPendingTasks_m { 0 };
+    std::atomic<std::size_t> nextWorker_m { 0 };
+    std::mutex parkingMutex_m {};
+    std::condition_variable_any parkingCondition_m {};
+    std::vector<std::jthread> threads_m {};
+};
+
+// Fork/join scope: tasks ``run`` in the group may execute on any worker, ``wait`` returns once all of them
+// finished. A waiting thread runs pending tasks meanwhile, so groups may be nested freely, and parks once
+// there are none left to run. The first exception a task throws is rethrown by ``wait``, the destructor
+// only waits.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(Scheduler& scheduler = Scheduler::global());
+    ~TaskGroup();
+
+    TaskGroup(TaskGroup const&) = delete;
+    TaskGroup& operator=(TaskGroup const&) = delete;
+
+    void run(Scheduler::task_t task);
+    void wait();
+
+private:
+    // outlives the group for as long as one of its tasks still holds on to it.
+    struct State
+    {
+        std::atomic<std::size_t> numberOfRunningTasks { 0 };
+        std::mutex mutex {};
+        std::exception_ptr exception {};
+    };
+
+    void wait_for_tasks();
+
+    Scheduler& scheduler_m;
+    std::shared_ptr<State> state_m;
+};
+
+// runs ``function(index)`` for every index in [begin, end), handing out chunks of at least ``grain`` indices.
+template <class Function>
+void parallel_for(std::size_t const begin, std::size_t const end, std::size_t const grain, Function const& function, Scheduler& scheduler = Scheduler::global())
+{
+    if (begin >= end) { return; }
+
+    auto const numberOfChunks = std::clamp((end - begin) / std::max(grain, 1zu), 1zu, 4 * scheduler.number_of_workers());
+    auto const chunkSize      = (end - begin + numberOfChunks - 1) / numberOfChunks;
+
+    TaskGroup taskGroup { scheduler };
+
+    for (auto chunkBegin = begin + chunkSize; chunkBegin < end; chunkBegin += chunkSize)
+    {
+        taskGroup.run([&function, chunkBegin, chunkEnd = std::min(chunkBegin + chunkSize, end)] {
+            for (auto index = chunkBegin; index != chunkEnd; index += 1) { function(index); }
+        });
+    }
+
+    for (auto index = begin; index != std::min(begin + chunkSize, end); index += 1) { function(index); }
+
+    taskGroup.wait();
+}
+
+// maps every index in [begin, end) and combines the results, chunk by chunk and then chunk results in
+// order, so ``reduce`` only needs to be associative.
+template <class T, class Map, class Reduce>
+T parallel_reduce(std::size_t const begin, std::size_t const end, std::size_t const grain, T const identity, Map const& map, Reduce const& reduce, Scheduler& scheduler = Scheduler::global())
+{
+    if (begin >= end) { return identity; }
+
+    auto const numberOfChunks = std::clamp((end - begin) / std::max(grain, 1zu), 1zu, 4 * scheduler.number_of_workers());
+    auto const chunkSize      = (end - begin + numberOfChunks - 1) / numberOfChunks;
+
+    std::vector<T> partialResults(numberOfChunks, identity);
+
+    parallel_for(0, numberOfChunks, 1, [&] (std::size_t const chunk) {
+        auto result = identity;
+
+        for (auto index = begin + chunk * chunkSize; index < std::min(begin + (chunk + 1) * chunkSize, end); index += 1)
+        {
+            result = reduce(std::move(result), map(index));
+        }
+
+        partialResults[chunk] = std::move(result);
+    }, scheduler);
+
+    auto result = identity;
+    for (auto& partialResult : partialResults) { result = reduce(std::move(result), std::move(partialResult)); }
+
+    return result;
+}
+
+}
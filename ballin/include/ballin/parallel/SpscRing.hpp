@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ballin::parallel {
+
+// Bounded lock-free queue between exactly one producer and one consumer thread. ``push`` blocks
+// while the ring is full, which is what throttles a fast producer down to the pace of its consumer.
+// A blocked side spins for a little while, then yields, and past that parks until the other side
+// moves, so a stage that is left waiting doesn't keep a core busy.
+//
+// Either side may ``close`` the ring: the producer when it is done, after which the consumer drains
+// what is left, or the consumer when it doesn't want anything else, after which pushes fail.
+template <class T>
+class SpscRing
+{
+public:
+    explicit SpscRing(std::size_t const capacity):
+        slots_m(std::bit_ceil(capacity)),
+        mask_m(slots_m.size() - 1)
+    {}
+
+    // returns false, leaving ``value`` untouched, if the consumer closed the ring.
+    bool push(T& value)
+    {
+        auto const tail = tail_m.load(std::memory_order_relaxed);
+
+        for (auto attempt = 0zu; tail - cachedHead_m == slots_m.size(); attempt += 1)
+        {
+            if (closed_m.load(std::memory_order_acquire)) { return false; }
+
+            cachedHead_m = head_m.load(std::memory_order_acquire);
+            if (tail - cachedHead_m != slots_m.size()) { break; }
+
+            backoff(attempt, [&] { return tail - head_m.load(std::memory_order_acquire) != slots_m.size() || closed_m.load(std::memory_order_acquire); });
+        }
+
+        if (closed_m.load(std::memory_order_relaxed)) { return false; }
+
+        slots_m[tail & mask_m] = std::move(value);
+        tail_m.store(tail + 1, std::memory_order_release);
+
+        wake_parked();
+
+        return true;
+    }
+
+    // returns std::nullopt once the ring is closed and every value pushed before that was popped.
+    std::optional<T> pop()
+    {
+        auto const head = head_m.load(std::memory_order_relaxed);
+
+        for (auto attempt = 0zu; head == cachedTail_m; attempt += 1)
+        {
+            cachedTail_m = tail_m.load(std::memory_order_acquire);
+
+            if (head != cachedTail_m) { break; }
+
+            if (closed_m.load(std::memory_order_acquire))
+            {
+                // the producer may have pushed right before closing.
+                cachedTail_m = tail_m.load(std::memory_order_acquire);
+                if (head == cachedTail_m) { return std::nullopt; }
+                break;
+            }
+
+            backoff(attempt, [&] { return head != tail_m.load(std::memory_order_acquire) || closed_m.load(std::memory_order_acquire); });
+        }
+
+        std::optional<T> value { std::move(slots_m[head & mask_m]) };
+        head_m.store(head + 1, std::memory_order_release);
+
+        wake_parked();
+
+        return value;
+    }
+
+    void close()
+    {
+        closed_m.store(true, std::memory_order_release);
+
+        // whoever is parked has to notice, regardless of whether the other side moved.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        signal_m.fetch_add(1, std::memory_order_release);
+        signal_m.notify_all();
+    }
+
+    bool is_closed() const { return closed_m.load(std::memory_order_acquire); }
+
+private:
+    static constexpr std::size_t SPINS_BEFORE_YIELDING = 64;
+    static constexpr std::size_t SPINS_BEFORE_PARKING  = 256;
+    static constexpr std::size_t CACHE_LINE_SIZE       = 64;
+
+    // ``isReady`` tells whether the side waiting can go on, it is checked once more right before parking.
+    template <class IsReady>
+    void backoff(std::size_t const attempt, IsReady const& isReady)
+    {
+        if (attempt < SPINS_BEFORE_YIELDING) { return; }
+        if (attempt < SPINS_BEFORE_PARKING) { std::this_thread::yield(); return; }
+
+        auto const signal = signal_m.load(std::memory_order_acquire);
+
+        // announcing the wait before checking once more pairs with ``wake_parked`` publishing the move
+        // before looking for someone to wake, so that either this side sees the move or the other one
+        // sees it parked.
+        numberOfParkedThreads_m.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!isReady()) { signal_m.wait(signal, std::memory_order_acquire); }
+
+        numberOfParkedThreads_m.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void wake_parked()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (numberOfParkedThreads_m.load(std::memory_order_relaxed) == 0) { return; }
+
+        signal_m.fetch_add(1, std::memory_order_release);
+        signal_m.notify_all();
+    }
+
+    std::vector<T> slots_m;
+    std::size_t mask_m;
+
+    // producer and consumer each own a cache line, so they only share one when they have to.
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_m { 0 };
+    std::size_t cachedHead_m { 0 };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_m { 0 };
+    std::size_t cachedTail_m { 0 };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> closed_m { false };
+    // bumped whenever a parked side may go on, which is what it waits on.
+    std::atomic<std::uint32_t> signal_m { 0 };
+    std::atomic<std::uint32_t> numberOfParkedThreads_m { 0 };
+};
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ballin::parallel {
+
+// Threads for tasks that block for as long as they run, like the stages of a pipelined line waiting on
+// each other through rings. Those can't go to the ``Scheduler``: with fewer workers than stages, every
+// worker may end up blocked on a stage that nobody is left to run.
+//
+// Every task gets a thread of its own. Threads are started when all of them are busy and kept around
+// once their task is done, so lines after the first reuse them instead of starting threads of their own.
+class StagePool
+{
+public:
+    using task_t = std::move_only_function<void()>;
+
+    StagePool() = default;
+    ~StagePool();
+
+    StagePool(StagePool const&) = delete;
+    StagePool& operator=(StagePool const&) = delete;
+
+    static StagePool& global();
+
+    void run(task_t task);
+
+private:
+    void work(std::stop_token const stopToken);
+
+    std::mutex mutex_m {};
+    std::condition_variable_any condition_m {};
+    std::deque<task_t> tasks_m {};
+    std::size_t numberOfIdleThreads_m { 0 };
+    std::vector<std::jthread> threads_m {};
+};
+
+// Join scope for a ``StagePool``: ``wait`` returns once all the tasks ``run`` in the group finished.
+class StageGroup
+{
+public:
+    explicit StageGroup(StagePool& pool = StagePool::global());
+    ~StageGroup();
+
+    StageGroup(StageGroup const&) = delete;
+    StageGroup& operator=(StageGroup const&) = delete;
+
+    void run(StagePool::task_t task);
+    void wait();
+
+private:
+    StagePool& pool_m;
+    std::shared_ptr<std::atomic<std::size_t>> numberOfRunningTasks_m;
+};
+
+}
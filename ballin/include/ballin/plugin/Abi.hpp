@@ -0,0 +1,53 @@
+#pragma once
+
+// Stable C ABI between ballin and command modules. A module is a shared object exporting
+// ``ballin_plugin_register`` (see ``BALLIN_PLUGIN_ENTRY_POINT``), which hands back a static table
+// describing every command it provides. Only plain C types cross the boundary, so modules may be
+// written in any language and built with any compiler.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BALLIN_PLUGIN_ABI_VERSION 1u
+#define BALLIN_PLUGIN_ENTRY_POINT "ballin_plugin_register"
+
+typedef struct ballin_string
+{
+    char const* data;
+    size_t size;
+} ballin_string;
+
+// results are handed back one at a time through ``push``, the host copies the bytes immediately.
+typedef struct ballin_result_sink
+{
+    void* context;
+    void (*push)(void* context, char const* data, size_t size);
+} ballin_result_sink;
+
+// returns zero on success, any other value is reported as a failure of the command.
+typedef int (*ballin_command_action)(ballin_string const* arguments, size_t numberOfArguments, ballin_result_sink const* results);
+
+typedef struct ballin_command_entry
+{
+    char const* name;
+    size_t expectedNumberOfArguments;
+    ballin_command_action action;
+} ballin_command_entry;
+
+typedef struct ballin_plugin_table
+{
+    uint32_t abiVersion;
+    char const* moduleName;
+    size_t numberOfCommands;
+    ballin_command_entry const* commands;
+} ballin_plugin_table;
+
+typedef ballin_plugin_table const* (*ballin_plugin_entry_point)(void);
+
+#ifdef __cplusplus
+}
+#endif
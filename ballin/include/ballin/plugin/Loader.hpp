@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Commands.hpp"
+#include "plugin/Module.hpp"
+
+#include <expected>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ballin::plugin {
+
+// Keeps track of the command modules registered into ``Commands`` and of which commands each one provides.
+//
+// A module ``name.so`` may come with a ``name.manifest`` next to it, listing one
+// ``<command> <number of arguments>`` pair per line. Modules with a manifest are registered from
+// it and only loaded once one of their commands is used; the others are loaded right away so their
+// table can be read.
+class Loader
+{
+public:
+    explicit Loader(Commands& commands);
+
+    void load_directory(std::filesystem::path const& directory);
+
+    // Loads the current contents of the module file and atomically replaces its commands in the registry.
+    // Invocations already running keep the previous version alive; it is unloaded once the last of them,
+    // and every registry snapshot referring to it, goes away. Returns the number of commands now provided.
+    std::expected<std::size_t, std::string> reload(std::string_view const moduleName);
+
+    std::vector<std::string> module_names() const;
+
+private:
+    struct LoadedModule
+    {
+        std::filesystem::path path;
+        std::size_t generation;
+        std::vector<std::string> commandNames;
+    };
+
+    std::expected<std::vector<Command>, std::string> make_commands(std::shared_ptr<Module> const& module) const;
+
+    Commands& commands_m;
+    mutable std::mutex mutex_m {};
+    std::map<std::string, LoadedModule, std::less<>> modules_m {};
+};
+
+}
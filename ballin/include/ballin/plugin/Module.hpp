@@ -0,0 +1,44 @@
+#pragma once
+
+#include "plugin/Abi.hpp"
+
+#include <expected>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace ballin::plugin {
+
+// A command module on disk. The shared object is only ``dlopen``ed the first time one of its
+// commands is looked up, and ``dlclose``d when the last reference to the module goes away.
+//
+// Past the first generation the module is loaded from a private copy of the file, since the dynamic
+// loader would otherwise hand back the still loaded previous version.
+class Module
+{
+public:
+    explicit Module(std::filesystem::path const& path, std::size_t const generation = 0);
+    ~Module();
+
+    Module(Module const&) = delete;
+    Module& operator=(Module const&) = delete;
+
+    constexpr auto const& path() const { return path_m; }
+    constexpr auto generation() const { return generation_m; }
+    bool is_loaded() const;
+
+    std::expected<ballin_plugin_table const*, std::string> table();
+    std::expected<ballin_command_entry const*, std::string> command(std::string_view const commandName);
+
+private:
+    std::expected<ballin_plugin_table const*, std::string> load();
+
+    std::filesystem::path path_m {};
+    std::size_t generation_m {};
+    mutable std::mutex mutex_m {};
+    void* handle_m {};
+    ballin_plugin_table const* table_m {};
+};
+
+}
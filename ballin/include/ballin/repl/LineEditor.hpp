@@ -0,0 +1,33 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ballin::repl {
+
+// Minimal line editor for interactive sessions. When stdin is a terminal it switches to raw mode
+// for the duration of a line so that <TAB> can be answered from the completer; otherwise it
+// behaves like a plain ``std::getline``.
+class LineEditor
+{
+public:
+    using completer_t = std::function<std::vector<std::string>(std::string_view)>;
+
+    explicit LineEditor(completer_t const completer);
+
+    // returns std::nullopt once the input is exhausted. the line is only valid until the next call, its
+    // storage is reused from one line to the next.
+    std::optional<std::string_view> read_line(std::string_view const prompt);
+
+private:
+    std::optional<std::string_view> read_raw_line(std::string_view const prompt);
+    void complete_line(std::string& line, std::string_view const prompt) const;
+
+    completer_t completer_m {};
+    std::string line_m {};
+};
+
+}
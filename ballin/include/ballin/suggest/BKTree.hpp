@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ballin::suggest {
+
+// Burkhard-Keller tree over edit distance, used to look up words within a given tolerance
+// without comparing the query against every word in the set.
+class BKTree
+{
+public:
+    struct Match
+    {
+        std::string_view word;
+        std::size_t distance;
+    };
+
+    void insert(std::string_view const word);
+
+    // matches are sorted by distance, ties broken alphabetically.
+    std::vector<Match> search(std::string_view const query, std::size_t const tolerance) const;
+
+    constexpr auto size() const { return nodes_m.size(); }
+    constexpr auto empty() const { return nodes_m.empty(); }
+
+private:
+    struct Node
+    {
+        std::string word;
+        std::size_t maximumChildDistance;
+        std::vector<std::pair<std::size_t, std::size_t>> children;
+    };
+
+    std::vector<Node> nodes_m {};
+};
+
+}
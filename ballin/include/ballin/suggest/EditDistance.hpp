@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ballin::suggest {
+
+// Levenshtein distance against a fixed pattern using Myers' bit-parallel algorithm.
+// Patterns longer than 64 bytes fall back to the row-by-row dynamic programming table.
+class LevenshteinPattern
+{
+public:
+    explicit LevenshteinPattern(std::string_view const pattern);
+
+    constexpr auto const& pattern() const { return pattern_m; }
+
+    // returns std::nullopt as soon as the distance is known to exceed ``bound``.
+    std::optional<std::size_t> distance(std::string_view const text, std::size_t const bound) const;
+    std::size_t distance(std::string_view const text) const;
+
+private:
+    std::optional<std::size_t> bit_parallel_distance(std::string_view const text, std::size_t const bound) const;
+    std::optional<std::size_t> table_distance(std::string_view const text, std::size_t const bound) const;
+
+    std::string pattern_m {};
+    std::array<std::uint64_t, 256> peq_m {};
+};
+
+std::optional<std::size_t> calculate_edit_distance(std::string_view const from, std::string_view const to, std::size_t const bound);
+std::size_t calculate_edit_distance(std::string_view const from, std::string_view const to);
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ballin::suggest {
+
+// Radix tree over a set of words, answering "every word starting with ``prefix``" in time
+// proportional to the prefix length plus the number of words reported.
+class PrefixTrie
+{
+public:
+    PrefixTrie();
+
+    void insert(std::string_view const word);
+
+    // completions are reported in lexicographic order, at most ``limit`` of them.
+    std::vector<std::string> complete(std::string_view const prefix, std::size_t const limit = std::numeric_limits<std::size_t>::max()) const;
+
+    constexpr auto size() const { return numberOfWords_m; }
+
+private:
+    struct Node
+    {
+        std::string label;
+        bool terminal;
+        std::vector<std::size_t> children;
+    };
+
+    std::vector<std::size_t>::const_iterator find_child(std::size_t const node, char const byte) const;
+    void collect(std::size_t const node, std::string& word, std::vector<std::string>& completions, std::size_t const limit) const;
+
+    std::vector<Node> nodes_m {};
+    std::size_t numberOfWords_m {};
+};
+
+}
@@ -0,0 +1,83 @@
+#include "Batch.hpp"
+
+#include "io/NumericCodec.hpp"
+
+namespace ballin {
+
+std::size_t Batch::size() const
+{
+    switch (type_m)
+    {
+    case Type::TEXT: return texts_m.size();
+    case Type::INTEGER: return integers_m.size();
+    case Type::REAL: return reals_m.size();
+    }
+
+    return 0;
+}
+
+void Batch::reset(Type const type)
+{
+    type_m = type;
+    texts_m.clear();
+    integers_m.clear();
+    reals_m.clear();
+}
+
+void Batch::truncate(std::size_t const size)
+{
+    if (size >= this->size()) { return; }
+
+    switch (type_m)
+    {
+    case Type::TEXT: texts_m.resize(size); break;
+    case Type::INTEGER: integers_m.resize(size); break;
+    case Type::REAL: reals_m.resize(size); break;
+    }
+}
+
+std::string Batch::text(std::size_t const index) const
+{
+    if (type_m == Type::TEXT) { return texts_m[index]; }
+
+    std::string text {};
+    append_text(index, text);
+    return text;
+}
+
+void Batch::append_text(std::size_t const index, std::string& output) const
+{
+    switch (type_m)
+    {
+    case Type::TEXT: output.append(texts_m[index]); return;
+    case Type::INTEGER: io::append_integer(output, integers_m[index]); return;
+    case Type::REAL: io::append_real(output, reals_m[index]); return;
+    }
+}
+
+std::expected<float, std::string> Batch::real(std::size_t const index) const
+{
+    switch (type_m)
+    {
+    case Type::TEXT: return io::parse_real(texts_m[index]);
+    case Type::INTEGER: return static_cast<float>(integers_m[index]);
+    case Type::REAL: return reals_m[index];
+    }
+
+    return {};
+}
+
+std::expected<std::size_t, std::string> Batch::integer(std::size_t const index) const
+{
+    switch (type_m)
+    {
+    case Type::TEXT: return io::parse_integer(texts_m[index]);
+    case Type::INTEGER: return integers_m[index];
+    // read from its text, the way a scalar command given it would, so that only whole numbers make it.
+    case Type::REAL: return io::parse_integer(text(index));
+    }
+
+    return {};
+}
+
+}
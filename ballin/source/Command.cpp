@@ -0,0 +1,62 @@
+#include "Command.hpp"
+
+#include "memory/LineArena.hpp"
+
+#include <algorithm>
+
+namespace ballin {
+
+Command::return_t Command::operator()() const
+{
+    if (!action_m)
+    {
+        return std::invoke(streamAction_m, argumentsStack_m, Stream {}).collect();
+    }
+
+    // copied into the line's scratch memory and moved from there on, rather than copied onto the heap.
+    return std::invoke(action_m, arguments_t { argumentsStack_m, memory::line_resource() });
+}
+
+Command::return_t Command::operator()(arguments_t argumentsStack) const
+{
+    if (!action_m)
+    {
+        return std::invoke(streamAction_m, argumentsStack_m, Stream::from(std::move(argumentsStack))).collect();
+    }
+
+    arguments_t localArgumentsStack { argumentsStack_m, memory::line_resource() };
+
+    std::ranges::for_each(argumentsStack, [&] (auto&& argument) {
+        localArgumentsStack.push_back(std::move(argument));
+    });
+
+    return std::invoke(action_m, std::move(localArgumentsStack));
+}
+
+std::optional<math::Program> Command::program() const
+{
+    // a scalar command run as a stage folds its input into trailing arguments rather than running once
+    // per value, so only the program of a streaming stage (``apply`` and the like) describes the stage.
+    if (!is_streaming()) { return std::nullopt; }
+
+    return program(argumentsStack_m);
+}
+
+std::optional<math::Program> Command::program(arguments_t const& arguments) const
+{
+    if (!program_m) { return std::nullopt; }
+
+    return std::invoke(program_m, arguments);
+}
+
+Stream Command::stream(Stream input) const
+{
+    if (streamAction_m)
+    {
+        return std::invoke(streamAction_m, arguments_t { argumentsStack_m, memory::line_resource() }, std::move(input));
+    }
+
+    return Stream::from((*this)(input.collect()));
+}
+
+}
@@ -0,0 +1,131 @@
+#include "CommandCache.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace ballin {
+
+namespace {
+
+void insert_bounded(auto& map, std::string_view const key, std::shared_ptr<Command const> command)
+{
+    // the lines of a session rarely stop repeating, starting over is good enough once there are too many.
+    if (map.size() == CommandCache::CAPACITY) { map.clear(); }
+
+    map.insert_or_assign(std::string { key }, std::move(command));
+}
+
+}
+
+void CommandCache::synchronize(std::size_t const version)
+{
+    if (version == version_m) { return; }
+
+    lines_m.clear();
+    templates_m.clear();
+    version_m = version;
+}
+
+std::shared_ptr<Command const> CommandCache::find(std::string_view const line)
+{
+    auto const cachedLine = lines_m.find(line);
+
+    if (cachedLine == lines_m.end()) { return nullptr; }
+
+    lineHits_m.fetch_add(1, std::memory_order_relaxed);
+
+    return cachedLine->second;
+}
+
+std::shared_ptr<Command const> CommandCache::find_template(std::string_view const line, std::span<Tokenizer::Token const> tokens)
+{
+    auto const cachedTemplate = templates_m.find(template_of(tokens));
+    auto const numberOfPipes  = std::ranges::count(tokens, Tokenizer::Token::Type::PIPE, &Tokenizer::Token::type);
+
+    // a name could contain the separators of the template, make sure the stages line up before reusing it.
+    if (cachedTemplate == templates_m.end() || cachedTemplate->second->subcommands().size() != static_cast<std::size_t>(numberOfPipes))
+    {
+        misses_m.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    templateHits_m.fetch_add(1, std::memory_order_relaxed);
+
+    auto command = std::make_shared<Command>(*cachedTemplate->second);
+
+    auto* stage      = command.get();
+    auto subcommand  = command->subcommands().begin();
+    auto isName      = true;
+
+    for (auto const& token : tokens)
+    {
+        if (token.type == Tokenizer::Token::Type::PIPE)
+        {
+            stage  = &*subcommand++;
+            isName = true;
+        }
+        else if (isName)
+        {
+            stage->clear_arguments();
+            isName = false;
+        }
+        else
+        {
+            stage->push_back_argument(token.text);
+        }
+    }
+
+    insert_bounded(lines_m, line, command);
+
+    return command;
+}
+
+void CommandCache::insert(std::string_view const line, std::span<Tokenizer::Token const> tokens, std::shared_ptr<Command const> command)
+{
+    insert_bounded(templates_m, template_of(tokens), command);
+    insert_bounded(lines_m, line, std::move(command));
+}
+
+CommandCache::Statistics CommandCache::statistics() const
+{
+    return {
+        lineHits_m.load(std::memory_order_relaxed),
+        templateHits_m.load(std::memory_order_relaxed),
+        misses_m.load(std::memory_order_relaxed)
+    };
+}
+
+std::string_view CommandCache::template_of(std::span<Tokenizer::Token const> tokens)
+{
+    template_m.clear();
+
+    auto isName = true;
+    auto numberOfArguments = 0zu;
+
+    for (auto const& token : tokens)
+    {
+        if (token.type == Tokenizer::Token::Type::PIPE)
+        {
+            std::format_to(std::back_inserter(template_m), "\t{}|", numberOfArguments);
+            isName = true;
+            numberOfArguments = 0;
+            continue;
+        }
+
+        if (isName)
+        {
+            template_m += token.text;
+            isName = false;
+            continue;
+        }
+
+        numberOfArguments += 1;
+    }
+
+    std::format_to(std::back_inserter(template_m), "\t{}", numberOfArguments);
+
+    return template_m;
+}
+
+}
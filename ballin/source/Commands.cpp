@@ -0,0 +1,116 @@
+#include "Commands.hpp"
+
+#include "io/Output.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+
+namespace ballin {
+
+namespace {
+
+void handle_non_existing_command(suggest::BKTree const& availableCommands, std::string_view const commandName)
+{
+    io::print("the command `{}` doesn't exist.", commandName);
+
+    // a suggestion has to be more than 70% similar to the typed name, i.e. ``distance * 10 < size * 3``.
+    // since ``distance >= |size difference|``, that can never hold past ``3/7`` of the typed length.
+    auto const tolerance = commandName.size() * 3 / 7;
+
+    auto similarCommands = availableCommands.search(commandName, tolerance) | std::views::filter([&] (auto&& match) {
+        auto const size = std::ranges::max(commandName.size(), match.word.size());
+        return match.distance * 10 < size * 3;
+    });
+
+    if (similarCommands.empty()) { io::print("\n"); }
+    else
+    {
+        io::println(" did you mean:");
+
+        for (auto const& match : similarCommands)
+        {
+            io::println("    - {}", match.word);
+        }
+    }
+}
+
+}
+
+Commands::Commands():
+    snapshot_m(std::make_shared<Snapshot const>())
+{
+}
+
+bool Commands::contains(std::string_view const commandName) const
+{
+    return snapshot()->commands.contains(std::string { commandName });
+}
+
+std::optional<Command> Commands::command(std::string_view const commandName) const
+{
+    auto const snapshot = this->snapshot();
+    auto const command  = snapshot->commands.find(std::string { commandName });
+
+    if (command == snapshot->commands.end())
+    {
+        handle_non_existing_command(snapshot->suggestions, commandName);
+        return std::nullopt;
+    }
+
+    return command->second;
+}
+
+std::vector<std::string> Commands::completions(std::string_view const prefix) const
+{
+    return snapshot()->completions.complete(prefix);
+}
+
+void Commands::register_command(Command command)
+{
+    register_commands({ std::move(command) });
+}
+
+void Commands::register_commands(std::vector<Command> commands)
+{
+    replace_commands({}, std::move(commands));
+}
+
+void Commands::replace_commands(std::vector<std::string> const& removedCommandNames, std::vector<Command> commands)
+{
+    std::scoped_lock const lock { writerMutex_m };
+
+    auto nextSnapshot = std::make_shared<Snapshot>(*snapshot());
+
+    if (!removedCommandNames.empty())
+    {
+        for (auto const& commandName : removedCommandNames)
+        {
+            nextSnapshot->commands.erase(commandName);
+        }
+
+        // neither index supports removal, rebuild both from the remaining names.
+        nextSnapshot->suggestions = {};
+        nextSnapshot->completions = {};
+
+        for (auto const& commandName : std::views::keys(nextSnapshot->commands))
+        {
+            nextSnapshot->suggestions.insert(commandName);
+            nextSnapshot->completions.insert(commandName);
+        }
+    }
+
+    for (auto& command : commands)
+    {
+        assert(nextSnapshot->commands.contains(command.name()) != true);
+        nextSnapshot->suggestions.insert(command.name());
+        nextSnapshot->completions.insert(command.name());
+        nextSnapshot->commands[command.name()] = std::move(command);
+    }
+
+    nextSnapshot->version += 1;
+
+    snapshot_m.store(std::move(nextSnapshot), std::memory_order_release);
+}
+
+}
@@ -0,0 +1,433 @@
+#include "Interpreter.hpp"
+
+#include "io/MappedFile.hpp"
+#include "io/NumberScanner.hpp"
+#include "io/Output.hpp"
+#include "memory/LineArena.hpp"
+#include "parallel/SpscRing.hpp"
+#include "parallel/StagePool.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <expected>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ballin {
+
+namespace {
+
+constexpr std::size_t PIPELINE_RING_CAPACITY = 8;
+
+// closes the ring once the reading end goes away, so that the producer stops instead of waiting on a full ring forever.
+struct RingReader
+{
+    explicit RingReader(std::shared_ptr<parallel::SpscRing<Batch>> ringToRead):
+        ring(std::move(ringToRead))
+    {}
+
+    RingReader(RingReader&&) = default;
+    RingReader& operator=(RingReader&&) = default;
+
+    ~RingReader()
+    {
+        if (ring != nullptr) { ring->close(); }
+    }
+
+    std::shared_ptr<parallel::SpscRing<Batch>> ring;
+};
+
+// the values in a file given with ``< file``, read as whitespace separated numbers straight off its mapping.
+std::expected<Stream, std::string> open_input(std::string const& path)
+{
+    auto mappedFile = io::MappedFile::open(path);
+
+    if (!mappedFile.has_value()) { return std::unexpected(std::move(mappedFile.error())); }
+
+    return Stream { [mappedFile = std::move(mappedFile.value()), position = 0zu] (Batch& batch) mutable -> bool {
+        return io::scan_numbers(mappedFile.contents(), position, batch);
+    }};
+}
+
+// writes a file out as it is, for lines that are nothing but redirections.
+void copy_input(std::string const& path)
+{
+    auto const descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (descriptor == -1)
+    {
+        io::println("couldn't open `{}`: {}.", path, std::strerror(errno));
+        return;
+    }
+
+    io::write_file(descriptor);
+
+    ::close(descriptor);
+}
+
+}
+
+Interpreter::Interpreter(Commands const& commands):
+    commands_m(commands),
+    parser_m(commands),
+    preparer_m(commands)
+{
+}
+
+void Interpreter::enqueue_command(std::string_view input)
+{
+    enqueue_command(parse_command(input));
+}
+
+Parser::Line Interpreter::parse_command(std::string_view input)
+{
+    return parser_m.parse(input, true);
+}
+
+Parser::Line Interpreter::prepare_command(std::string_view input)
+{
+    // taken before parsing, so that a registry changing halfway through leaves the line stale rather than mixed.
+    auto const version = commands_m.version();
+
+    auto preparedLine    = preparer_m.parse(input, false);
+    preparedLine.version = version;
+
+    return preparedLine;
+}
+
+Parser::Line Interpreter::prepare_command(TokenizedLine const& line)
+{
+    auto const version = commands_m.version();
+
+    auto preparedLine    = preparer_m.parse(line, false);
+    preparedLine.version = version;
+
+    return preparedLine;
+}
+
+bool Interpreter::is_stale(Parser::Line const& line) const
+{
+    return line.version != commands_m.version();
+}
+
+void Interpreter::enqueue_command(Parser::Line const& line)
+{
+    switch (line.type)
+    {
+    case Parser::Line::Type::NOTHING: break;
+    case Parser::Line::Type::UNPARSED: break;
+    case Parser::Line::Type::PIPELINE:
+    case Parser::Line::Type::COPY: {
+        queuedCommands_m.push(line);
+        break;
+    }
+    case Parser::Line::Type::EXPLAIN: {
+        run_line(line, &arena_m);
+        break;
+    }
+    }
+}
+
+void Interpreter::run_line(Parser::Line const& line, std::pmr::memory_resource* resource) const
+{
+    // first, so that it outlives everything the line makes out of it.
+    memory::LineArena const lineArena { resource };
+
+    auto const& [inputPath, outputPath, append] = line.redirections;
+
+    // errors opening the files are reported where the output would have gone otherwise.
+    Stream input {};
+
+    if (inputPath.has_value() && line.type == Parser::Line::Type::PIPELINE)
+    {
+        auto maybeInput = open_input(inputPath.value());
+
+        if (!maybeInput.has_value())
+        {
+            io::println("{}", maybeInput.error());
+            return;
+        }
+
+        input = std::move(maybeInput.value());
+    }
+
+    std::unique_ptr<io::Sink> outputSink {};
+
+    if (outputPath.has_value())
+    {
+        auto maybeOutputSink = io::Sink::open(outputPath.value(), append, { OUTPUT_FILE_BUFFER_SIZE, io::Sink::FlushPolicy::FULL });
+
+        if (!maybeOutputSink.has_value())
+        {
+            io::println("{}", maybeOutputSink.error());
+            return;
+        }
+
+        outputSink = std::move(maybeOutputSink.value());
+    }
+
+    std::optional<io::Redirect> redirect {};
+    if (outputSink != nullptr) { redirect.emplace(*outputSink); }
+
+    switch (line.type)
+    {
+    case Parser::Line::Type::NOTHING: break;
+    case Parser::Line::Type::UNPARSED: break;
+    case Parser::Line::Type::PIPELINE: {
+        run_command(*line.command, std::move(input), resource);
+        break;
+    }
+    case Parser::Line::Type::EXPLAIN: {
+        explain(*line.command, resource);
+        break;
+    }
+    case Parser::Line::Type::COPY: {
+        copy_input(inputPath.value());
+        break;
+    }
+    }
+}
+
+void Interpreter::explain(Command const& masterCommand, std::pmr::memory_resource* resource) const
+{
+    auto const plannedCommand = plan(masterCommand, resource);
+    auto command              = plannedCommand.commands.begin();
+
+    for (auto index = 0zu; index != plannedCommand.stages.size(); index += 1)
+    {
+        auto const& stage = plannedCommand.stages[index];
+
+        io::print("stage {}: {}", index, stage.numberOfCommands == 1 ? "" : "fused [");
+
+        for (auto separator = std::string_view {}; auto const* fusedCommand : std::ranges::subrange(command, command + static_cast<std::ptrdiff_t>(stage.numberOfCommands)))
+        {
+            io::print("{}{}", separator, fusedCommand->name());
+            for (auto const& argument : fusedCommand->arguments_stack()) { io::print(" {}", argument); }
+            separator = " | ";
+        }
+
+        io::println("{}", stage.numberOfCommands == 1 ? "" : "]");
+
+        command += static_cast<std::ptrdiff_t>(stage.numberOfCommands);
+    }
+}
+
+CommandCache::Statistics Interpreter::cache_statistics() const
+{
+    auto const [lineHits, templateHits, misses] = parser_m.statistics();
+    auto const [preparedLineHits, preparedTemplateHits, preparedMisses] = preparer_m.statistics();
+
+    return { lineHits + preparedLineHits, templateHits + preparedTemplateHits, misses + preparedMisses };
+}
+
+Interpreter::Plan Interpreter::plan(Command const& masterCommand, std::pmr::memory_resource* resource) const
+{
+    Plan plannedCommand { resource };
+
+    plannedCommand.commands.reserve(masterCommand.subcommands().size() + 1);
+    plannedCommand.commands.push_back(&masterCommand);
+    for (auto const& subcommand : masterCommand.subcommands()) { plannedCommand.commands.push_back(&subcommand); }
+
+    // reserved up front so that the stages can point into it.
+    plannedCommand.fusedCommands.reserve(plannedCommand.commands.size() / 2);
+
+    for (auto command = plannedCommand.commands.begin(); command != plannedCommand.commands.end();)
+    {
+        auto program = (*command)->program();
+
+        auto fusedCommand = std::next(command);
+
+        for (; program.has_value() && fusedCommand != plannedCommand.commands.end(); ++fusedCommand)
+        {
+            auto const nextProgram = (*fusedCommand)->program();
+            if (!nextProgram.has_value()) { break; }
+            program.value().then(nextProgram.value());
+        }
+
+        auto const numberOfCommands = static_cast<std::size_t>(std::distance(command, fusedCommand));
+
+        if (numberOfCommands < 2)
+        {
+            plannedCommand.stages.push_back({ *command, 1 });
+            command = std::next(command);
+            continue;
+        }
+
+        plannedCommand.fusedCommands.push_back(Command { "fused", 0, [program = std::move(program.value())] (Command::arguments_t, Stream input) -> Stream {
+            return Stream { [program, input = std::move(input), batch = Batch {}] (Batch& output) mutable -> bool {
+                while (input.next_batch(batch))
+                {
+                    if (batch.empty()) { continue; }
+                    transform_reals(batch, output, [&] (float value) { return program.evaluate(value); });
+                    return true;
+                }
+
+                return false;
+            }};
+        }});
+
+        plannedCommand.stages.push_back({ &plannedCommand.fusedCommands.back(), numberOfCommands });
+
+        command = fusedCommand;
+    }
+
+    return plannedCommand;
+}
+
+std::vector<std::string> Interpreter::complete(std::string_view input) const
+{
+    auto const wordStart = input.find_last_of(" |") == std::string_view::npos ? 0 : input.find_last_of(" |") + 1;
+    auto const word      = input.substr(wordStart);
+    auto context         = input.substr(0, wordStart);
+
+    while (!context.empty() && context.back() == ' ') { context.remove_suffix(1); }
+
+    auto const previousWordStart = context.find_last_of(" |") == std::string_view::npos ? 0 : context.find_last_of(" |") + 1;
+    auto const previousWord      = context.substr(previousWordStart);
+
+    if (context.empty() || context.back() == '|' || previousWord == "apply" || previousWord == "explain")
+    {
+        return commands_m.completions(word);
+    }
+
+    return {};
+}
+
+Command::Effect Interpreter::effect_of(Parser::Line const& line) const
+{
+    switch (line.type)
+    {
+    case Parser::Line::Type::NOTHING: return Command::Effect::PURE;
+    case Parser::Line::Type::EXPLAIN: return Command::Effect::OUTPUT;
+    case Parser::Line::Type::UNPARSED: return Command::Effect::OUTPUT;
+    case Parser::Line::Type::COPY: return Command::Effect::BARRIER;
+    case Parser::Line::Type::PIPELINE: break;
+    }
+
+    // files may be read by lines after it, or written by lines before it.
+    if (line.redirections.input.has_value() || line.redirections.output.has_value()) { return Command::Effect::BARRIER; }
+
+    auto const snapshot = commands_m.snapshot();
+
+    auto fnEffectOf = [&snapshot] (Command const& command) {
+        if (command.effect() != Command::Effect::OF_TARGET) { return command.effect(); }
+
+        // the target may come from the previous stage, there's no telling what it is then.
+        if (command.arguments_stack().empty()) { return Command::Effect::BARRIER; }
+
+        auto const maybeTarget = snapshot->commands.find(command.arguments_stack().front());
+
+        // running it reports that it doesn't exist.
+        if (maybeTarget == snapshot->commands.end()) { return Command::Effect::OUTPUT; }
+
+        auto const targetEffect = maybeTarget->second.effect();
+
+        return targetEffect == Command::Effect::OF_TARGET ? Command::Effect::BARRIER : targetEffect;
+    };
+
+    // the effects are ordered from the least to the most restrictive.
+    auto effect = fnEffectOf(*line.command);
+
+    for (auto const& subcommand : line.command->subcommands())
+    {
+        effect = std::max(effect, fnEffectOf(subcommand));
+    }
+
+    return effect;
+}
+
+void Interpreter::run(Parser::Line const& line) const
+{
+    std::array<std::byte, ARENA_SIZE> arenaBuffer;
+    std::pmr::monotonic_buffer_resource arena { arenaBuffer.data(), arenaBuffer.size() };
+
+    run_line(line, &arena);
+}
+
+void Interpreter::execute()
+{
+    while (!queuedCommands_m.empty())
+    {
+        run_line(queuedCommands_m.front(), &arena_m);
+        queuedCommands_m.pop();
+    }
+
+    // nothing planned for the line outlives it, so its scratch memory can go all at once.
+    arena_m.release();
+}
+
+void Interpreter::run_command(Command const& masterCommand, Stream input, std::pmr::memory_resource* resource) const
+{
+    auto const plannedCommand = plan(masterCommand, resource);
+
+    if (executionMode_m == ExecutionMode::PIPELINED && plannedCommand.stages.size() > 1)
+    {
+        execute_pipelined(plannedCommand, std::move(input));
+        return;
+    }
+
+    auto operationResult = std::move(input);
+
+    for (auto const& stage : plannedCommand.stages)
+    {
+        operationResult = stage.command->stream(std::move(operationResult));
+    }
+
+    // nothing is computed until the last stage is pulled from.
+    while (operationResult.next().has_value()) {}
+}
+
+void Interpreter::execute_pipelined(Plan const& plannedCommand, Stream input) const
+{
+    auto const& stages = plannedCommand.stages;
+
+    // every stage but the last blocks on its neighbours for as long as the line runs, each gets a thread
+    // of the pool. declared first so that it waits for them only after the rings were closed.
+    parallel::StageGroup stageGroup {};
+
+    auto operationResult = std::move(input);
+
+    for (auto const& stage : stages | std::views::take(stages.size() - 1))
+    {
+        auto ring = std::make_shared<parallel::SpscRing<Batch>>(PIPELINE_RING_CAPACITY);
+
+        stageGroup.run([ring, command = stage.command, input = std::move(operationResult)] () mutable {
+            auto output = command->stream(std::move(input));
+
+            Batch batch {};
+
+            while (output.next_batch(batch))
+            {
+                if (!ring->push(batch)) { break; }
+            }
+
+            ring->close();
+        });
+
+        operationResult = Stream { [reader = RingReader { ring }] (Batch& batch) -> bool {
+            auto maybeBatch = reader.ring->pop();
+
+            if (!maybeBatch.has_value()) { return false; }
+
+            batch = std::move(maybeBatch.value());
+
+            return true;
+        }};
+    }
+
+    operationResult = stages.back().command->stream(std::move(operationResult));
+
+    while (operationResult.next().has_value()) {}
+
+    // dropping the stream closes the ring feeding it, which unblocks anything still producing upstream.
+    operationResult = {};
+}
+
+}
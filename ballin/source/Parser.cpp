@@ -0,0 +1,190 @@
+#include "Parser.hpp"
+
+#include "io/Output.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace ballin {
+
+Parser::Parser(Commands const& commands):
+    commands_m(commands)
+{
+}
+
+std::optional<Command> Parser::parse_command(std::span<Tokenizer::Token const> tokens, bool const reportErrors) const
+{
+    if (tokens.empty())
+    {
+        if (reportErrors) { io::println("expected a command."); }
+        return std::nullopt;
+    }
+
+    std::optional<Command> masterCommand {};
+
+    while (true)
+    {
+        auto const stageEnd = std::ranges::find(tokens, Tokenizer::Token::Type::PIPE, &Tokenizer::Token::type);
+        auto const stage    = std::span { tokens.begin(), stageEnd };
+
+        if (stage.empty())
+        {
+            if (reportErrors) { io::println("expected a command {}.", masterCommand.has_value() ? "after `|`" : "before `|`"); }
+            return std::nullopt;
+        }
+
+        // looking a missing command up reports it, along with suggestions.
+        if (!reportErrors && !commands_m.contains(stage.front().text)) { return std::nullopt; }
+
+        auto maybeCommand = commands_m.command(stage.front().text);
+
+        if (!maybeCommand.has_value()) { return std::nullopt; }
+
+        for (auto const& argument : stage.subspan(1))
+        {
+            maybeCommand.value().push_back_argument(argument.text);
+        }
+
+        if (!masterCommand.has_value())
+        {
+            masterCommand = std::move(maybeCommand);
+        }
+        else
+        {
+            masterCommand.value().push_subcommand(std::move(maybeCommand.value()));
+        }
+
+        if (stageEnd == tokens.end()) { break; }
+
+        tokens = std::span { std::next(stageEnd), tokens.end() };
+    }
+
+    return masterCommand;
+}
+
+bool Parser::take_redirections(std::span<Tokenizer::Token const> tokens, Redirections& redirections, bool const reportErrors)
+{
+    commandTokens_m.clear();
+
+    for (auto token = tokens.begin(); token != tokens.end(); ++token)
+    {
+        if (token->type == Tokenizer::Token::Type::WORD || token->type == Tokenizer::Token::Type::PIPE)
+        {
+            commandTokens_m.push_back(*token);
+            continue;
+        }
+
+        auto const path = std::next(token);
+
+        if (path == tokens.end() || path->type != Tokenizer::Token::Type::WORD)
+        {
+            if (reportErrors) { io::println("expected a file after `{}`.", token->text); }
+            return false;
+        }
+
+        // the last one given wins, like in a shell.
+        if (token->type == Tokenizer::Token::Type::REDIRECT_INPUT)
+        {
+            redirections.input = std::string { path->text };
+        }
+        else
+        {
+            redirections.output = std::string { path->text };
+            redirections.append = token->type == Tokenizer::Token::Type::APPEND_OUTPUT;
+        }
+
+        token = path;
+    }
+
+    return true;
+}
+
+Parser::Line Parser::parse(std::string_view const input, bool const reportErrors)
+{
+    commandCache_m.synchronize(commands_m.version());
+
+    if (auto cachedCommand = commandCache_m.find(input))
+    {
+        return { Line::Type::PIPELINE, std::move(cachedCommand) };
+    }
+
+    return parse_tokens(input, tokenizer_m.tokenize(input), reportErrors);
+}
+
+Parser::Line Parser::parse(TokenizedLine const& line, bool const reportErrors)
+{
+    commandCache_m.synchronize(commands_m.version());
+
+    if (auto cachedCommand = commandCache_m.find(line.text()))
+    {
+        return { Line::Type::PIPELINE, std::move(cachedCommand) };
+    }
+
+    return parse_tokens(line.text(), line.tokens(), reportErrors);
+}
+
+Parser::Line Parser::parse_tokens(std::string_view const input, std::expected<std::span<Tokenizer::Token const>, std::string> const& maybeTokens, bool const reportErrors)
+{
+    auto const failure = reportErrors ? Line::Type::NOTHING : Line::Type::UNPARSED;
+
+    if (!maybeTokens.has_value())
+    {
+        if (reportErrors) { io::println("{}", maybeTokens.error()); }
+        return { failure, nullptr };
+    }
+
+    auto tokens = maybeTokens.value();
+
+    if (tokens.empty()) { return { Line::Type::NOTHING, nullptr }; }
+
+    Redirections redirections {};
+
+    // redirected lines aren't cached, the cache only knows about the pipelines.
+    auto const isRedirected = std::ranges::any_of(tokens, [] (auto const& token) {
+        return token.type != Tokenizer::Token::Type::WORD && token.type != Tokenizer::Token::Type::PIPE;
+    });
+
+    if (isRedirected)
+    {
+        if (!take_redirections(tokens, redirections, reportErrors)) { return { failure, nullptr }; }
+
+        tokens = commandTokens_m;
+
+        if (tokens.empty() && redirections.input.has_value()) { return { Line::Type::COPY, nullptr, std::move(redirections) }; }
+    }
+
+    if (!tokens.empty() && tokens.front().type == Tokenizer::Token::Type::WORD && tokens.front().text == "explain")
+    {
+        auto masterCommand = parse_command(tokens.subspan(1), reportErrors);
+
+        if (!masterCommand.has_value()) { return { failure, nullptr }; }
+
+        return { Line::Type::EXPLAIN, std::make_shared<Command const>(std::move(masterCommand.value())), std::move(redirections) };
+    }
+
+    if (isRedirected)
+    {
+        auto masterCommand = parse_command(tokens, reportErrors);
+
+        if (!masterCommand.has_value()) { return { failure, nullptr }; }
+
+        return { Line::Type::PIPELINE, std::make_shared<Command const>(std::move(masterCommand.value())), std::move(redirections) };
+    }
+
+    if (auto cachedCommand = commandCache_m.find_template(input, tokens))
+    {
+        return { Line::Type::PIPELINE, std::move(cachedCommand) };
+    }
+
+    auto masterCommand = parse_command(tokens, reportErrors);
+
+    if (!masterCommand.has_value()) { return { failure, nullptr }; }
+
+    auto preparedCommand = std::make_shared<Command const>(std::move(masterCommand.value()));
+
+    commandCache_m.insert(input, tokens, preparedCommand);
+
+    return { Line::Type::PIPELINE, std::move(preparedCommand) };
+}
+
+}
@@ -0,0 +1,81 @@
+#include "ScriptRunner.hpp"
+
+#include "io/Output.hpp"
+#include "parallel/Scheduler.hpp"
+
+namespace ballin {
+
+ScriptRunner::ScriptRunner(Interpreter& interpreter):
+    interpreter_m(interpreter),
+    lines_m(WINDOW_SIZE),
+    preparedLines_m(WINDOW_SIZE),
+    outputs_m(WINDOW_SIZE)
+{
+}
+
+void ScriptRunner::run(read_line_t readLine)
+{
+    while (true)
+    {
+        auto numberOfLines = 0zu;
+
+        for (; numberOfLines != WINDOW_SIZE; numberOfLines += 1)
+        {
+            auto const line = readLine();
+            if (!line.has_value()) { break; }
+            lines_m[numberOfLines].assign(line.value());
+            outputs_m[numberOfLines].clear();
+        }
+
+        if (numberOfLines == 0) { break; }
+
+        // lines are only parsed once every barrier before them ran, since a barrier may change the
+        // registered commands.
+        for (auto index = 0zu; index != numberOfLines;)
+        {
+            auto const segmentBegin = index;
+
+            for (; index != numberOfLines; index += 1)
+            {
+                prepare_line(index);
+                if (interpreter_m.effect_of(preparedLines_m[index]) == Command::Effect::BARRIER) { break; }
+            }
+
+            run_lines(segmentBegin, index);
+
+            if (index != numberOfLines)
+            {
+                interpreter_m.run(preparedLines_m[index]);
+                io::Sink::standard_output().end_line();
+                index += 1;
+            }
+        }
+    }
+}
+
+void ScriptRunner::prepare_line(std::size_t const index)
+{
+    preparedLines_m[index] = interpreter_m.prepare_command(lines_m[index]);
+
+    if (preparedLines_m[index].type == Parser::Line::Type::UNPARSED)
+    {
+        io::Capture const capture { outputs_m[index] };
+        preparedLines_m[index] = interpreter_m.parse_command(lines_m[index]);
+    }
+}
+
+void ScriptRunner::run_lines(std::size_t const begin, std::size_t const end)
+{
+    parallel::parallel_for(begin, end, 1, [this] (std::size_t const index) {
+        io::Capture const capture { outputs_m[index] };
+        interpreter_m.run(preparedLines_m[index]);
+    });
+
+    for (auto index = begin; index != end; index += 1)
+    {
+        io::write(outputs_m[index]);
+        io::Sink::standard_output().end_line();
+    }
+}
+
+}
@@ -0,0 +1,116 @@
+#include "Stream.hpp"
+
+#include "memory/LineArena.hpp"
+
+#include <utility>
+
+namespace ballin {
+
+Stream::Stream(pull_t pull):
+    pull_m(std::move(pull))
+{
+}
+
+Stream::Stream(batch_pull_t pullBatch):
+    pullBatch_m(std::move(pullBatch))
+{
+}
+
+Stream Stream::from(values_t values)
+{
+    return Stream { [values = std::move(values)] () mutable -> std::optional<value_t> {
+        if (values.empty()) { return std::nullopt; }
+
+        auto value = std::move(values.front());
+        values.pop_front();
+
+        return value;
+    }};
+}
+
+Stream Stream::concat(Stream first, Stream second)
+{
+    return Stream { [first = std::move(first), second = std::move(second)] () mutable -> std::optional<value_t> {
+        if (auto value = first.next(); value.has_value()) { return value; }
+        return second.next();
+    }};
+}
+
+std::optional<Stream::value_t> Stream::next()
+{
+    if (pullBatch_m)
+    {
+        if (pendingIndex_m == pending_m.size())
+        {
+            pending_m.reset(Batch::Type::TEXT);
+            pendingIndex_m = 0;
+
+            if (!pullBatch_m(pending_m) || pending_m.empty())
+            {
+                pullBatch_m = nullptr;
+                return std::nullopt;
+            }
+        }
+
+        return pending_m.text(pendingIndex_m++);
+    }
+
+    if (!pull_m) { return std::nullopt; }
+
+    auto value = pull_m();
+
+    // drop whatever state the producer holds as soon as it runs dry.
+    if (!value.has_value()) { pull_m = nullptr; }
+
+    return value;
+}
+
+bool Stream::next_batch(Batch& batch)
+{
+    batch.reset(Batch::Type::TEXT);
+
+    if (pullBatch_m)
+    {
+        // values left over from a previous ``next()`` go first, in their textual form.
+        if (pendingIndex_m != pending_m.size())
+        {
+            while (pendingIndex_m != pending_m.size())
+            {
+                batch.texts().push_back(pending_m.text(pendingIndex_m++));
+            }
+
+            return true;
+        }
+
+        if (!pullBatch_m(batch) || batch.empty())
+        {
+            pullBatch_m = nullptr;
+            return false;
+        }
+
+        return true;
+    }
+
+    while (batch.size() != Batch::CAPACITY)
+    {
+        auto value = next();
+        if (!value.has_value()) { break; }
+        batch.texts().push_back(std::move(value.value()));
+    }
+
+    return !batch.empty();
+}
+
+Stream::values_t Stream::collect()
+{
+    values_t values { memory::line_resource() };
+
+    while (auto value = next())
+    {
+        values.push_back(std::move(value.value()));
+    }
+
+    return values;
+}
+
+}
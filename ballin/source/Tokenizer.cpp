@@ -0,0 +1,141 @@
+#include "Tokenizer.hpp"
+
+#include <algorithm>
+#include <format>
+
+namespace ballin {
+
+namespace {
+
+constexpr auto is_blank(char const character) { return character == ' ' || character == '\t'; }
+constexpr auto is_operator(char const character) { return character == '|' || character == '<' || character == '>'; }
+
+}
+
+std::expected<std::span<Tokenizer::Token const>, std::string> Tokenizer::tokenize(std::string_view const input)
+{
+    tokens_m.clear();
+    unquoted_m.clear();
+    // unquoting never makes a word longer, so the views into the buffer stay valid as it's appended to.
+    unquoted_m.reserve(input.size());
+
+    auto index = 0zu;
+
+    while (index != input.size())
+    {
+        if (is_blank(input[index]))
+        {
+            index += 1;
+            continue;
+        }
+
+        if (is_operator(input[index]))
+        {
+            auto const isAppend = input.substr(index).starts_with(">>");
+            auto const type     = input[index] == '|' ? Token::Type::PIPE : input[index] == '<' ? Token::Type::REDIRECT_INPUT : isAppend ? Token::Type::APPEND_OUTPUT : Token::Type::REDIRECT_OUTPUT;
+            auto const length   = isAppend ? 2zu : 1zu;
+
+            tokens_m.push_back({ type, input.substr(index, length) });
+            index += length;
+            continue;
+        }
+
+        auto const wordStart     = index;
+        auto const unquotedStart = unquoted_m.size();
+        auto isVerbatim          = true;
+
+        while (index != input.size() && !is_blank(input[index]) && !is_operator(input[index]))
+        {
+            auto const character = input[index];
+
+            if (character != '\\' && character != '"' && character != '\'')
+            {
+                if (!isVerbatim) { unquoted_m.push_back(character); }
+                index += 1;
+                continue;
+            }
+
+            if (isVerbatim)
+            {
+                unquoted_m.append(input.substr(wordStart, index - wordStart));
+                isVerbatim = false;
+            }
+
+            if (character == '\\')
+            {
+                if (index + 1 == input.size()) { return std::unexpected(std::format("the line ends with an escape at column {}.", index + 1)); }
+
+                unquoted_m.push_back(input[index + 1]);
+                index += 2;
+                continue;
+            }
+
+            auto const quoteStart = index;
+
+            for (index += 1; index != input.size() && input[index] != character; index += 1)
+            {
+                if (character == '"' && input[index] == '\\' && index + 1 != input.size()) { index += 1; }
+                unquoted_m.push_back(input[index]);
+            }
+
+            if (index == input.size()) { return std::unexpected(std::format("the quote at column {} is never closed.", quoteStart + 1)); }
+
+            index += 1;
+        }
+
+        auto const word = isVerbatim
+            ? input.substr(wordStart, index - wordStart)
+            : std::string_view { unquoted_m }.substr(unquotedStart);
+
+        tokens_m.push_back({ Token::Type::WORD, word });
+    }
+
+    return tokens_m;
+}
+
+TokenizedLine::TokenizedLine(Tokenizer& tokenizer, std::string_view const input):
+    size_m(input.size())
+{
+    auto const maybeTokens = tokenizer.tokenize(input);
+
+    if (!maybeTokens.has_value())
+    {
+        storage_m = std::make_unique_for_overwrite<char[]>(input.size());
+        std::ranges::copy(input, storage_m.get());
+        error_m = maybeTokens.error();
+        return;
+    }
+
+    auto const unquoted = std::string_view { tokenizer.unquoted_m };
+
+    storage_m = std::make_unique_for_overwrite<char[]>(input.size() + unquoted.size());
+    std::ranges::copy(input, storage_m.get());
+    std::ranges::copy(unquoted, storage_m.get() + input.size());
+
+    tokens_m.reserve(maybeTokens.value().size());
+
+    // the tokens view either the line or the buffer of the tokenizer, they are pointed at the copies of those instead.
+    for (auto const& token : maybeTokens.value())
+    {
+        // words quoted down to nothing view nothing in particular.
+        if (token.text.empty())
+        {
+            tokens_m.push_back({ token.type, std::string_view {} });
+            continue;
+        }
+
+        auto const isUnquoted = token.text.data() >= unquoted.data() && token.text.data() < unquoted.data() + unquoted.size();
+        auto const offset     = isUnquoted ? input.size() + static_cast<std::size_t>(token.text.data() - unquoted.data()) : static_cast<std::size_t>(token.text.data() - input.data());
+
+        tokens_m.push_back({ token.type, std::string_view { storage_m.get() + offset, token.text.size() } });
+    }
+}
+
+std::expected<std::span<Tokenizer::Token const>, std::string> TokenizedLine::tokens() const
+{
+    if (!error_m.empty()) { return std::unexpected(error_m); }
+
+    return tokens_m;
+}
+
+}
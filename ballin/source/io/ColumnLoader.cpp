@@ -0,0 +1,236 @@
+#include "io/ColumnLoader.hpp"
+
+#include "io/MappedFile.hpp"
+#include "io/NumberScanner.hpp"
+#include "io/NumericCodec.hpp"
+#include "io/Output.hpp"
+#include "parallel/Scheduler.hpp"
+
+#include <array>
+#include <format>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ballin::io {
+
+namespace {
+
+// chunks are cut at the first line boundary past this many bytes.
+constexpr std::size_t CHUNK_SIZE = 1 << 20;
+
+// what tells the columns apart, no delimiter standing for any run of whitespace.
+constexpr char WHITESPACE = '\0';
+
+constexpr auto is_whitespace(char const character) { return character == ' ' || character == '\t' || character == '\r'; }
+
+std::string_view trim(std::string_view field)
+{
+    while (!field.empty() && is_whitespace(field.front())) { field.remove_prefix(1); }
+    while (!field.empty() && is_whitespace(field.back())) { field.remove_suffix(1); }
+    return field;
+}
+
+// calls ``function(index, field)`` for every field of ``line``, stopping as soon as it returns false.
+template <class Function>
+void for_each_field(std::string_view const line, char const delimiter, Function function)
+{
+    auto index    = 0zu;
+    auto position = 0zu;
+
+    while (position <= line.size())
+    {
+        if (delimiter == WHITESPACE)
+        {
+            while (position != line.size() && is_whitespace(line[position])) { position += 1; }
+            if (position == line.size()) { return; }
+        }
+
+        auto fieldEnd = position;
+        while (fieldEnd != line.size() && (delimiter == WHITESPACE ? !is_whitespace(line[fieldEnd]) : line[fieldEnd] != delimiter)) { fieldEnd += 1; }
+
+        if (!function(index, trim(line.substr(position, fieldEnd - position)))) { return; }
+
+        index    += 1;
+        position  = fieldEnd + 1;
+    }
+}
+
+// parses one chunk of whole lines into ``batches``. empty fields count as positions all the same, a row
+// without a value where one is expected is left out entirely instead, so that the values of the other
+// rows stay where they belong. returns how many rows were left out, blank lines aside.
+std::size_t load_chunk(std::string_view chunk, char const delimiter, std::optional<std::size_t> const column, std::vector<Batch>& batches)
+{
+    batches.clear();
+
+    std::array<std::string_view, Batch::CAPACITY> fields {};
+    auto numberOfFields = 0zu;
+    auto numberOfSkippedRows = 0zu;
+
+    auto fnAddField = [&] (std::string_view const field) {
+        fields[numberOfFields++] = field;
+
+        if (numberOfFields == fields.size())
+        {
+            read_numbers(fields, batches.emplace_back());
+            numberOfFields = 0;
+        }
+    };
+
+    while (!chunk.empty())
+    {
+        auto const lineEnd = std::min(chunk.find('\n'), chunk.size());
+        auto const line    = chunk.substr(0, lineEnd);
+
+        chunk.remove_prefix(std::min(lineEnd + 1, chunk.size()));
+
+        if (trim(line).empty()) { continue; }
+
+        if (column.has_value())
+        {
+            std::string_view value {};
+
+            for_each_field(line, delimiter, [&] (std::size_t const index, std::string_view const field) {
+                if (index == column.value()) { value = field; }
+                return index != column.value();
+            });
+
+            if (value.empty()) { numberOfSkippedRows += 1; }
+            else               { fnAddField(value); }
+
+            continue;
+        }
+
+        // only fields between two delimiters can be empty, whitespace separated rows never have any.
+        auto hasEmptyField = false;
+
+        if (delimiter != WHITESPACE)
+        {
+            for_each_field(line, delimiter, [&] (std::size_t, std::string_view const field) {
+                hasEmptyField = field.empty();
+                return !hasEmptyField;
+            });
+        }
+
+        if (hasEmptyField)
+        {
+            numberOfSkippedRows += 1;
+            continue;
+        }
+
+        for_each_field(line, delimiter, [&] (std::size_t, std::string_view const field) {
+            fnAddField(field);
+            return true;
+        });
+    }
+
+    if (numberOfFields != 0) { read_numbers(std::span { fields }.first(numberOfFields), batches.emplace_back()); }
+
+    return numberOfSkippedRows;
+}
+
+}
+
+std::expected<Stream, std::string> load_columns(std::filesystem::path const& path, std::optional<std::string_view> const column)
+{
+    auto mappedFile = MappedFile::open(path);
+
+    if (!mappedFile.has_value()) { return std::unexpected(std::move(mappedFile.error())); }
+
+    auto const contents  = mappedFile.value().contents();
+    auto const firstLine = contents.substr(0, contents.find('\n'));
+    auto const delimiter = firstLine.contains(',') ? ',' : WHITESPACE;
+
+    std::optional<std::size_t> columnIndex {};
+    auto bodyBegin = 0zu;
+
+    if (column.has_value())
+    {
+        if (auto const columnNumber = parse_integer(column.value()); columnNumber.has_value())
+        {
+            if (columnNumber.value() == 0) { return std::unexpected(std::string { "columns are counted from 1." }); }
+
+            columnIndex = columnNumber.value() - 1;
+
+            // a first line that isn't a number in that column is taken to be a header, as it would be for a named one.
+            auto isHeader = false;
+
+            for_each_field(firstLine, delimiter, [&] (std::size_t const index, std::string_view const field) {
+                if (index == columnIndex.value()) { isHeader = !field.empty() && !parse_real(field).has_value(); }
+                return index != columnIndex.value();
+            });
+
+            if (isHeader) { bodyBegin = std::min(firstLine.size() + 1, contents.size()); }
+        }
+        else
+        {
+            for_each_field(firstLine, delimiter, [&] (std::size_t const index, std::string_view const field) {
+                if (field == column.value()) { columnIndex = index; }
+                return !columnIndex.has_value();
+            });
+
+            if (!columnIndex.has_value()) { return std::unexpected(std::format("`{}` has no column named `{}`.", path.string(), column.value())); }
+
+            bodyBegin = std::min(firstLine.size() + 1, contents.size());
+        }
+    }
+
+    auto const chunksPerRound = 4 * parallel::Scheduler::global().number_of_workers();
+
+    return Stream {
+        [mappedFile = std::move(mappedFile.value()), path, delimiter, columnIndex, position = bodyBegin,
+         chunks = std::vector<std::vector<Batch>>(chunksPerRound), numberOfChunks = 0zu, nextChunk = 0zu, nextBatch = 0zu] (Batch& output) mutable -> bool {
+            while (true)
+            {
+                while (nextChunk != numberOfChunks)
+                {
+                    if (nextBatch != chunks[nextChunk].size())
+                    {
+                        std::swap(output, chunks[nextChunk][nextBatch++]);
+                        return true;
+                    }
+
+                    nextChunk += 1;
+                    nextBatch  = 0;
+                }
+
+                auto const fileContents = mappedFile.contents();
+
+                if (position == fileContents.size()) { return false; }
+
+                std::vector<std::string_view> chunkTexts {};
+
+                while (chunkTexts.size() != chunks.size() && position != fileContents.size())
+                {
+                    auto chunkEnd = std::min(position + CHUNK_SIZE, fileContents.size());
+                    chunkEnd      = chunkEnd == fileContents.size() ? chunkEnd : std::min(fileContents.find('\n', chunkEnd), fileContents.size() - 1) + 1;
+
+                    chunkTexts.push_back(fileContents.substr(position, chunkEnd - position));
+                    position = chunkEnd;
+                }
+
+                std::vector<std::size_t> numbersOfSkippedRows(chunkTexts.size());
+
+                parallel::parallel_for(0, chunkTexts.size(), 1, [&] (std::size_t const index) {
+                    numbersOfSkippedRows[index] = load_chunk(chunkTexts[index], delimiter, columnIndex, chunks[index]);
+                });
+
+                // reported here rather than by the chunks, so that it comes out once a round and in order.
+                if (auto const numberOfSkippedRows = std::accumulate(numbersOfSkippedRows.begin(), numbersOfSkippedRows.end(), 0zu); numberOfSkippedRows != 0)
+                {
+                    auto const rows = numberOfSkippedRows == 1 ? "row" : "rows";
+
+                    if (columnIndex.has_value()) { println("skipped {} {} of `{}` with no value in column {}.", numberOfSkippedRows, rows, path.string(), columnIndex.value() + 1); }
+                    else                         { println("skipped {} {} of `{}` with an empty field.", numberOfSkippedRows, rows, path.string()); }
+                }
+
+                numberOfChunks = chunkTexts.size();
+                nextChunk      = 0;
+                nextBatch      = 0;
+            }
+        }
+    };
+}
+
+}
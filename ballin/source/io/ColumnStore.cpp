@@ -0,0 +1,297 @@
+#include "io/ColumnStore.hpp"
+
+#include "io/MappedFile.hpp"
+#include "io/NumericCodec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <span>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ballin::io {
+
+namespace {
+
+constexpr std::array<char, 8> COLUMN_MAGIC { 'b', 'a', 'l', 'l', 'i', 'n', 'c', 'o' };
+constexpr std::uint32_t COLUMN_VERSION = 1;
+constexpr std::string_view COLUMN_EXTENSION = ".column";
+
+// values are written out once this many bytes of them piled up.
+constexpr std::size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "integers are stored as 64 bit ones.");
+
+struct ColumnHeader
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    // either ``Batch::Type::INTEGER`` or ``Batch::Type::REAL``.
+    std::uint32_t type;
+    std::uint64_t numberOfValues;
+    // keeps the values that follow aligned to their width.
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(ColumnHeader) == 32);
+
+constexpr std::size_t width_of(Batch::Type const type) { return type == Batch::Type::INTEGER ? sizeof(std::uint64_t) : sizeof(float); }
+
+std::string describe_error(std::filesystem::path const& path)
+{
+    return std::format("couldn't write `{}`: {}.", path.string(), std::strerror(errno));
+}
+
+// the column being stored, written to a file of its own that only takes the place of the old one once
+// every value made it to the disk.
+class ColumnWriter
+{
+public:
+    ColumnWriter(std::filesystem::path path, int const descriptor):
+        path_m(std::move(path)),
+        descriptor_m(descriptor)
+    {
+        buffer_m.reserve(WRITE_BUFFER_SIZE);
+    }
+
+    ~ColumnWriter()
+    {
+        ::close(descriptor_m);
+    }
+
+    ColumnWriter(ColumnWriter const&) = delete;
+    ColumnWriter& operator=(ColumnWriter const&) = delete;
+
+    constexpr auto number_of_values() const { return numberOfValues_m; }
+
+    std::expected<void, std::string> append(Batch const& batch)
+    {
+        if (numberOfValues_m == 0) { type_m = batch.type() == Batch::Type::INTEGER ? Batch::Type::INTEGER : Batch::Type::REAL; }
+
+        if (type_m == Batch::Type::INTEGER && batch.type() != Batch::Type::INTEGER)
+        {
+            if (auto const converted = convert_to_reals(); !converted.has_value()) { return converted; }
+        }
+
+        if (type_m == Batch::Type::INTEGER)
+        {
+            append_bytes(std::as_bytes(std::span { batch.integers() }));
+        }
+        else if (batch.type() == Batch::Type::REAL)
+        {
+            append_bytes(std::as_bytes(std::span { batch.reals() }));
+        }
+        else if (batch.type() == Batch::Type::INTEGER)
+        {
+            // the column went real earlier on, integers after that are widened to fit it.
+            for (auto const integer : batch.integers())
+            {
+                auto const value = static_cast<float>(integer);
+                append_bytes(std::as_bytes(std::span { &value, 1 }));
+            }
+        }
+        else
+        {
+            // text is stored as the numbers it spells, anything else can't be stored at all.
+            for (auto const& text : batch.texts())
+            {
+                auto const value = parse_real(text);
+
+                if (!value.has_value()) { return std::unexpected(value.error()); }
+
+                append_bytes(std::as_bytes(std::span { &value.value(), 1 }));
+            }
+        }
+
+        numberOfValues_m += batch.size();
+
+        if (buffer_m.size() >= WRITE_BUFFER_SIZE) { return flush(); }
+
+        return {};
+    }
+
+    std::expected<void, std::string> finish()
+    {
+        if (auto const flushed = flush(); !flushed.has_value()) { return flushed; }
+
+        ColumnHeader const header { COLUMN_MAGIC, COLUMN_VERSION, static_cast<std::uint32_t>(type_m), numberOfValues_m, 0 };
+
+        if (::pwrite(descriptor_m, &header, sizeof(header), 0) != sizeof(header)) { return std::unexpected(describe_error(path_m)); }
+
+        // the rename only makes the column durable if its contents reach the disk before it does.
+        if (::fsync(descriptor_m) == -1) { return std::unexpected(describe_error(path_m)); }
+
+        return {};
+    }
+
+private:
+    void append_bytes(std::span<std::byte const> const bytes)
+    {
+        buffer_m.insert(buffer_m.end(), bytes.begin(), bytes.end());
+    }
+
+    std::expected<void, std::string> flush()
+    {
+        for (auto written = 0zu; written != buffer_m.size();)
+        {
+            auto const result = ::write(descriptor_m, buffer_m.data() + written, buffer_m.size() - written);
+
+            if (result == -1 && errno == EINTR) { continue; }
+            if (result <= 0) { return std::unexpected(describe_error(path_m)); }
+
+            written += static_cast<std::size_t>(result);
+        }
+
+        buffer_m.clear();
+
+        return {};
+    }
+
+    // turns the integers stored so far into reals, in place. a real takes half the room an integer
+    // does, so going front to back never writes over integers that weren't read yet.
+    std::expected<void, std::string> convert_to_reals()
+    {
+        if (auto const flushed = flush(); !flushed.has_value()) { return flushed; }
+
+        std::array<std::uint64_t, Batch::CAPACITY> integers {};
+        std::array<float, Batch::CAPACITY> reals {};
+
+        for (auto index = 0zu; index < numberOfValues_m; index += integers.size())
+        {
+            auto const count = std::min(integers.size(), numberOfValues_m - index);
+
+            auto const readOffset  = static_cast<off_t>(sizeof(ColumnHeader) + index * sizeof(std::uint64_t));
+            auto const writeOffset = static_cast<off_t>(sizeof(ColumnHeader) + index * sizeof(float));
+
+            if (::pread(descriptor_m, integers.data(), count * sizeof(std::uint64_t), readOffset) != static_cast<ssize_t>(count * sizeof(std::uint64_t)))
+            {
+                return std::unexpected(describe_error(path_m));
+            }
+
+            std::transform(integers.begin(), integers.begin() + static_cast<std::ptrdiff_t>(count), reals.begin(), [] (std::uint64_t value) { return static_cast<float>(value); });
+
+            if (::pwrite(descriptor_m, reals.data(), count * sizeof(float), writeOffset) != static_cast<ssize_t>(count * sizeof(float)))
+            {
+                return std::unexpected(describe_error(path_m));
+            }
+        }
+
+        auto const size = static_cast<off_t>(sizeof(ColumnHeader) + numberOfValues_m * sizeof(float));
+
+        if (::ftruncate(descriptor_m, size) == -1 || ::lseek(descriptor_m, size, SEEK_SET) == -1) { return std::unexpected(describe_error(path_m)); }
+
+        type_m = Batch::Type::REAL;
+
+        return {};
+    }
+
+    std::filesystem::path path_m;
+    int descriptor_m {};
+    Batch::Type type_m { Batch::Type::INTEGER };
+    std::size_t numberOfValues_m {};
+    std::vector<std::byte> buffer_m {};
+};
+
+}
+
+std::filesystem::path column_path(std::string_view const name)
+{
+    return std::filesystem::path { name }.concat(COLUMN_EXTENSION);
+}
+
+std::expected<std::size_t, std::string> store_column(std::string_view const name, Stream values)
+{
+    if (name.empty() || name.contains('/')) { return std::unexpected(std::format("`{}` can't be the name of a column.", name)); }
+
+    auto const path          = column_path(name);
+    auto const temporaryPath = std::filesystem::path { path }.concat(".partial");
+
+    auto const descriptor = ::open(temporaryPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (descriptor == -1) { return std::unexpected(describe_error(temporaryPath)); }
+
+    ColumnWriter writer { temporaryPath, descriptor };
+
+    auto fnStore = [&] () -> std::expected<std::size_t, std::string> {
+        // the header is written last, once the number of values is known.
+        if (::lseek(descriptor, sizeof(ColumnHeader), SEEK_SET) == -1) { return std::unexpected(describe_error(temporaryPath)); }
+
+        Batch batch {};
+
+        while (values.next_batch(batch))
+        {
+            if (auto const appended = writer.append(batch); !appended.has_value()) { return std::unexpected(appended.error()); }
+        }
+
+        if (auto const finished = writer.finish(); !finished.has_value()) { return std::unexpected(finished.error()); }
+
+        return writer.number_of_values();
+    };
+
+    auto const stored = fnStore();
+
+    if (!stored.has_value())
+    {
+        ::unlink(temporaryPath.c_str());
+        return stored;
+    }
+
+    if (::rename(temporaryPath.c_str(), path.c_str()) == -1) { return std::unexpected(describe_error(path)); }
+
+    return stored;
+}
+
+std::expected<Stream, std::string> fetch_column(std::string_view const name)
+{
+    auto const path = column_path(name);
+    auto mappedFile = MappedFile::open(path);
+
+    if (!mappedFile.has_value()) { return std::unexpected(std::move(mappedFile.error())); }
+
+    auto const contents = mappedFile.value().contents();
+
+    ColumnHeader header {};
+    if (contents.size() >= sizeof(header)) { std::memcpy(&header, contents.data(), sizeof(header)); }
+
+    auto const type      = static_cast<Batch::Type>(header.type);
+    auto const isInvalid = contents.size() < sizeof(header)
+        || header.magic != COLUMN_MAGIC
+        || header.version != COLUMN_VERSION
+        || (type != Batch::Type::INTEGER && type != Batch::Type::REAL)
+        || (contents.size() - sizeof(header)) % width_of(type) != 0
+        || header.numberOfValues != (contents.size() - sizeof(header)) / width_of(type);
+
+    if (isInvalid) { return std::unexpected(std::format("`{}` isn't a column stored by this version of ballin.", path.string())); }
+
+    return Stream { [mappedFile = std::move(mappedFile.value()), type, numberOfValues = static_cast<std::size_t>(header.numberOfValues), index = 0zu] (Batch& batch) mutable -> bool {
+        if (index == numberOfValues) { return false; }
+
+        auto const count         = std::min(Batch::CAPACITY, numberOfValues - index);
+        auto const* const values = mappedFile.contents().data() + sizeof(ColumnHeader) + index * width_of(type);
+
+        batch.reset(type);
+
+        if (type == Batch::Type::INTEGER)
+        {
+            batch.integers().resize(count);
+            std::memcpy(batch.integers().data(), values, count * sizeof(std::uint64_t));
+        }
+        else
+        {
+            batch.reals().resize(count);
+            std::memcpy(batch.reals().data(), values, count * sizeof(float));
+        }
+
+        index += count;
+
+        return true;
+    }};
+}
+
+}
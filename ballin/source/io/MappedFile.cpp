@@ -0,0 +1,86 @@
+#include "io/MappedFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ballin::io {
+
+MappedFile::MappedFile(void* data, std::size_t const size):
+    data_m(data),
+    size_m(size)
+{
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept:
+    data_m(std::exchange(other.data_m, nullptr)),
+    size_m(std::exchange(other.size_m, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (data_m != nullptr) { munmap(data_m, size_m); }
+        data_m = std::exchange(other.data_m, nullptr);
+        size_m = std::exchange(other.size_m, 0);
+    }
+
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_m != nullptr) { munmap(data_m, size_m); }
+}
+
+std::expected<MappedFile, std::string> MappedFile::open(std::filesystem::path const& path)
+{
+    auto const descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (descriptor == -1)
+    {
+        return std::unexpected(std::format("couldn't open `{}`: {}.", path.string(), std::strerror(errno)));
+    }
+
+    auto mappedFile = open(descriptor);
+    ::close(descriptor);
+
+    if (!mappedFile.has_value())
+    {
+        return std::unexpected(std::format("couldn't map `{}`: {}", path.string(), mappedFile.error()));
+    }
+
+    return mappedFile;
+}
+
+std::expected<MappedFile, std::string> MappedFile::open(int const descriptor)
+{
+    struct stat status {};
+
+    if (fstat(descriptor, &status) == -1) { return std::unexpected(std::format("{}.", std::strerror(errno))); }
+    if (!S_ISREG(status.st_mode)) { return std::unexpected(std::string { "not a regular file." }); }
+
+    auto const size = static_cast<std::size_t>(status.st_size);
+
+    // there is nothing to map in an empty file, and ``mmap`` refuses a length of zero anyway.
+    if (size == 0) { return MappedFile { nullptr, 0 }; }
+
+    auto* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    if (data == MAP_FAILED) { return std::unexpected(std::format("{}.", std::strerror(errno))); }
+
+    // the contents are read front to back, so let the kernel read ahead aggressively.
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    return MappedFile { data, size };
+}
+
+}
@@ -0,0 +1,144 @@
+#include "io/NumberScanner.hpp"
+
+#include "io/NumericCodec.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ballin::io {
+
+namespace {
+
+constexpr std::size_t BLOCK_SIZE = 16;
+constexpr std::uint32_t BLOCK_MASK = (1u << BLOCK_SIZE) - 1;
+
+constexpr auto is_whitespace(char const character) { return character == ' ' || character == '\t' || character == '\n' || character == '\r'; }
+
+// one bit per byte of the block starting at ``data``, set where the byte is whitespace. bytes past the
+// first ``size`` ones count as whitespace, which is how the last field of the text gets closed.
+std::uint32_t whitespace_mask(char const* const data, std::size_t const size)
+{
+#if defined(__SSE2__)
+    if (size >= BLOCK_SIZE)
+    {
+        auto const block    = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+        auto const newlines = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\r')));
+        auto const blanks   = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t')));
+
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(newlines, blanks)));
+    }
+#endif
+
+    auto mask = 0u;
+
+    for (auto index = 0zu; index != BLOCK_SIZE; index += 1)
+    {
+        if (index >= size || is_whitespace(data[index])) { mask |= 1u << index; }
+    }
+
+    return mask;
+}
+
+// splits off up to ``fields.size()`` fields, returns how many it found.
+std::size_t split_fields(std::string_view const text, std::size_t& position, std::span<std::string_view> fields)
+{
+    constexpr auto NO_FIELD = std::string_view::npos;
+
+    auto numberOfFields = 0zu;
+    auto fieldBegin     = NO_FIELD;
+
+    while (position < text.size())
+    {
+        auto const mask = whitespace_mask(text.data() + position, text.size() - position);
+        auto offset     = 0zu;
+
+        // every iteration either opens or closes a field, jumping straight to where that happens.
+        while (offset != BLOCK_SIZE)
+        {
+            auto const remaining = mask >> offset;
+
+            if (fieldBegin == NO_FIELD)
+            {
+                auto const nonWhitespace = ~remaining & (BLOCK_MASK >> offset);
+                if (nonWhitespace == 0) { break; }
+
+                offset     += static_cast<std::size_t>(std::countr_zero(nonWhitespace));
+                fieldBegin  = position + offset;
+            }
+            else
+            {
+                if (remaining == 0) { break; }
+
+                offset += static_cast<std::size_t>(std::countr_zero(remaining));
+                fields[numberOfFields++] = text.substr(fieldBegin, position + offset - fieldBegin);
+                fieldBegin = NO_FIELD;
+
+                if (numberOfFields == fields.size())
+                {
+                    position += offset;
+                    return numberOfFields;
+                }
+            }
+        }
+
+        position += BLOCK_SIZE;
+    }
+
+    // the text ended right at the end of a block, in the middle of a field.
+    if (fieldBegin != NO_FIELD) { fields[numberOfFields++] = text.substr(fieldBegin); }
+
+    position = text.size();
+
+    return numberOfFields;
+}
+
+template <class T, class Parse>
+bool parse_fields(std::span<std::string_view const> fields, std::vector<T>& values, Parse parse)
+{
+    values.resize(fields.size());
+
+    for (auto index = 0zu; index != fields.size(); index += 1)
+    {
+        auto const value = parse(fields[index]);
+        if (!value.has_value()) { return false; }
+        values[index] = value.value();
+    }
+
+    return true;
+}
+
+}
+
+bool scan_numbers(std::string_view const text, std::size_t& position, Batch& batch)
+{
+    std::array<std::string_view, Batch::CAPACITY> fields {};
+
+    auto const numberOfFields = split_fields(text, position, fields);
+
+    if (numberOfFields == 0) { return false; }
+
+    read_numbers(std::span { fields }.first(numberOfFields), batch);
+
+    return true;
+}
+
+void read_numbers(std::span<std::string_view const> fields, Batch& batch)
+{
+    batch.reset(Batch::Type::INTEGER);
+    if (parse_fields(fields, batch.integers(), parse_integer)) { return; }
+
+    batch.reset(Batch::Type::REAL);
+    if (parse_fields(fields, batch.reals(), parse_real)) { return; }
+
+    batch.reset(Batch::Type::TEXT);
+    for (auto const field : fields) { batch.texts().emplace_back(field); }
+}
+
+}
@@ -0,0 +1,81 @@
+#include "io/NumericCodec.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <system_error>
+
+namespace ballin::io {
+
+namespace {
+
+template <class T>
+std::expected<T, std::string> parse_number(std::string_view const text)
+{
+    if (text.empty()) { return std::unexpected("expected a number."); }
+
+    // ``std::from_chars`` only takes the sign of negative numbers.
+    auto const digits = text.starts_with('+') ? text.substr(1) : text;
+
+    T value {};
+    auto const [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+
+    if (error == std::errc::result_out_of_range) { return std::unexpected(std::format("`{}` is out of range.", text)); }
+    if (error != std::errc {} || end != digits.data() + digits.size()) { return std::unexpected(std::format("`{}` is not a number.", text)); }
+
+    return value;
+}
+
+}
+
+std::expected<float, std::string> parse_real(std::string_view const text)
+{
+    return parse_number<float>(text);
+}
+
+std::expected<std::size_t, std::string> parse_integer(std::string_view const text)
+{
+    return parse_number<std::size_t>(text);
+}
+
+char* format_real(char* const first, char* const last, float const value)
+{
+    auto const magnitude = std::fabs(value);
+    auto const format    = magnitude == 0.0f || (magnitude >= 1e-4f && magnitude < 1e15f) ? std::chars_format::fixed : std::chars_format::scientific;
+
+    return std::to_chars(first, last, value, format).ptr;
+}
+
+char* format_integer(char* const first, char* const last, std::size_t const value, int const base)
+{
+    return std::to_chars(first, last, value, base).ptr;
+}
+
+void append_real(std::string& output, float const value)
+{
+    std::array<char, MAXIMUM_NUMBER_LENGTH> buffer {};
+    output.append(buffer.data(), format_real(buffer.data(), buffer.data() + buffer.size(), value));
+}
+
+void append_integer(std::string& output, std::size_t const value, int const base)
+{
+    std::array<char, MAXIMUM_NUMBER_LENGTH> buffer {};
+    output.append(buffer.data(), format_integer(buffer.data(), buffer.data() + buffer.size(), value, base));
+}
+
+std::string format_real(float const value)
+{
+    std::string text {};
+    append_real(text, value);
+    return text;
+}
+
+std::string format_integer(std::size_t const value, int const base)
+{
+    std::string text {};
+    append_integer(text, value, base);
+    return text;
+}
+
+}
@@ -0,0 +1,256 @@
+#include "io/Output.hpp"
+
+#include "io/MappedFile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <span>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace ballin::io {
+
+namespace {
+
+thread_local Capture* currentCapture = nullptr;
+thread_local Sink* currentSink       = nullptr;
+
+Destination exchange_destination(Destination const& destination)
+{
+    return { std::exchange(currentCapture, destination.capture), std::exchange(currentSink, destination.sink) };
+}
+
+std::mutex standardOutputOptionsMutex {};
+std::optional<Sink::Options> standardOutputOptions {};
+
+// ``writev`` may write less than it was given, carry on from wherever it stopped.
+void write_fully(int const descriptor, std::span<iovec> pieces)
+{
+    while (!pieces.empty())
+    {
+        auto const written = ::writev(descriptor, pieces.data(), static_cast<int>(pieces.size()));
+
+        if (written == -1)
+        {
+            if (errno == EINTR) { continue; }
+            // nowhere left to report it to, the output is gone.
+            return;
+        }
+
+        auto remaining = static_cast<std::size_t>(written);
+
+        while (!pieces.empty() && remaining >= pieces.front().iov_len)
+        {
+            remaining -= pieces.front().iov_len;
+            pieces = pieces.subspan(1);
+        }
+
+        if (!pieces.empty())
+        {
+            pieces.front().iov_base = static_cast<char*>(pieces.front().iov_base) + remaining;
+            pieces.front().iov_len -= remaining;
+        }
+    }
+}
+
+}
+
+Sink::Sink(int const descriptor, Options const& options):
+    descriptor_m(descriptor),
+    options_m(options)
+{
+    buffer_m.reserve(options_m.bufferSize);
+}
+
+Sink::~Sink()
+{
+    flush();
+
+    if (ownsDescriptor_m) { ::close(descriptor_m); }
+}
+
+std::expected<std::unique_ptr<Sink>, std::string> Sink::open(std::filesystem::path const& path, bool const append, Options const& options)
+{
+    auto const descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0644);
+
+    if (descriptor == -1)
+    {
+        return std::unexpected(std::format("couldn't open `{}` for writing: {}.", path.string(), std::strerror(errno)));
+    }
+
+    auto sink = std::make_unique<Sink>(descriptor, options);
+    sink->ownsDescriptor_m = true;
+
+    return sink;
+}
+
+Sink::Options Sink::default_options()
+{
+    return { 64 * 1024, isatty(STDOUT_FILENO) ? FlushPolicy::LINE : FlushPolicy::FULL };
+}
+
+void Sink::configure(Options const& options)
+{
+    std::scoped_lock const lock { standardOutputOptionsMutex };
+    standardOutputOptions = options;
+}
+
+Sink& Sink::standard_output()
+{
+    // flushed by its destructor when the program exits, ``quit`` included.
+    static Sink sink { STDOUT_FILENO, [] {
+        std::scoped_lock const lock { standardOutputOptionsMutex };
+        return standardOutputOptions.value_or(default_options());
+    }() };
+
+    return sink;
+}
+
+void Sink::write(std::string_view const text)
+{
+    std::scoped_lock const lock { mutex_m };
+
+    if (buffer_m.size() + text.size() <= options_m.bufferSize)
+    {
+        buffer_m.append(text);
+        return;
+    }
+
+    flush_locked(text);
+}
+
+void Sink::flush()
+{
+    std::scoped_lock const lock { mutex_m };
+    flush_locked();
+}
+
+void Sink::end_line()
+{
+    if (options_m.flushPolicy == FlushPolicy::LINE) { flush(); }
+}
+
+void Sink::write_file(int const descriptor)
+{
+    std::scoped_lock const lock { mutex_m };
+
+    flush_locked();
+
+    struct stat status {};
+    if (::fstat(descriptor, &status) == -1) { return; }
+
+    auto const offset = ::lseek(descriptor, 0, SEEK_CUR);
+    auto remaining    = static_cast<std::size_t>(std::max(status.st_size - std::max(offset, off_t {}), off_t {}));
+
+    while (remaining != 0)
+    {
+        auto const copied = ::copy_file_range(descriptor, nullptr, descriptor_m, nullptr, remaining, 0);
+
+        if (copied == -1 && errno == EINTR) { continue; }
+        // the destination is a terminal or a pipe, or the kernel can't copy between these two.
+        if (copied <= 0) { break; }
+
+        remaining -= static_cast<std::size_t>(copied);
+    }
+
+    if (remaining == 0) { return; }
+
+    if (auto const file = MappedFile::open(descriptor); file.has_value())
+    {
+        auto const contents = file.value().contents();
+        flush_locked(contents.substr(contents.size() - std::min(remaining, contents.size())));
+    }
+}
+
+void Sink::flush_locked(std::string_view const text)
+{
+    std::array<iovec, 2> pieces {{
+        { buffer_m.data(), buffer_m.size() },
+        { const_cast<char*>(text.data()), text.size() }
+    }};
+
+    write_fully(descriptor_m, pieces);
+    buffer_m.clear();
+}
+
+Destination current_destination()
+{
+    return { currentCapture, currentSink };
+}
+
+Capture* current_capture()
+{
+    return currentCapture;
+}
+
+Sink& current_sink()
+{
+    return currentSink != nullptr ? *currentSink : Sink::standard_output();
+}
+
+void write(std::string_view const text)
+{
+    if (currentCapture != nullptr)
+    {
+        currentCapture->write(text);
+        return;
+    }
+
+    current_sink().write(text);
+}
+
+void write_file(int const descriptor)
+{
+    if (currentCapture != nullptr)
+    {
+        if (auto const file = MappedFile::open(descriptor); file.has_value()) { currentCapture->write(file.value().contents()); }
+        return;
+    }
+
+    current_sink().write_file(descriptor);
+}
+
+Capture::Capture(std::string& target):
+    target_m(&target),
+    previousDestination_m(exchange_destination({ this, currentSink }))
+{
+}
+
+Capture::~Capture()
+{
+    exchange_destination(previousDestination_m);
+}
+
+void Capture::write(std::string_view const text)
+{
+    std::scoped_lock const lock { mutex_m };
+    target_m->append(text);
+}
+
+Redirect::Redirect(Sink& sink):
+    previousDestination_m(exchange_destination({ nullptr, &sink }))
+{
+}
+
+Redirect::~Redirect()
+{
+    exchange_destination(previousDestination_m);
+}
+
+Adopt::Adopt(Destination const& destination):
+    previousDestination_m(exchange_destination(destination))
+{
+}
+
+Adopt::~Adopt()
+{
+    exchange_destination(previousDestination_m);
+}
+
+}
@@ -1,413 +1,933 @@
 #include <bitset>
-#include <cassert>
+#include <cstdio>
+#include <cmath>
+#include <expected>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <print>
-#include <queue>
 #include <ranges>
 #include <algorithm>
-#include <sstream>
-
+#include <span>
+#include <vector>
+
+#include "Batch.hpp"
+#include "Commands.hpp"
+#include "Interpreter.hpp"
+#include "Parser.hpp"
+#include "ScriptRunner.hpp"
+#include "Stream.hpp"
+#include "Tokenizer.hpp"
+#include "io/ColumnLoader.hpp"
+#include "io/ColumnStore.hpp"
+#include "io/MappedFile.hpp"
+#include "io/NumberScanner.hpp"
+#include "io/NumericCodec.hpp"
+#include "io/Output.hpp"
 #include "math/Eval.hpp"
+#include "math/Program.hpp"
+#include "memory/AllocationCounter.hpp"
+#include "memory/LineArena.hpp"
+#include "parallel/Overlap.hpp"
+#include "parallel/Scheduler.hpp"
+#include "plugin/Loader.hpp"
+#include "repl/LineEditor.hpp"
+
+#include <unistd.h>
 
-namespace ballin {
+namespace {
 
-    namespace {
+constexpr std::size_t BATCH_OUTPUT_BUFFER_SIZE = 1 << 20;
 
-    auto calculate_edit_distance(std::string_view from, std::string_view to)
+// streaming commands receive the output of the previous stage as a stream instead of as trailing arguments,
+// so the arguments they require but weren't given are taken from the front of it.
+auto take_arguments(ballin::Command::arguments_t arguments, ballin::Stream& input, std::size_t const numberOfArguments)
+{
+    while (arguments.size() < numberOfArguments)
     {
-        if (from.empty()) { return to.size(); }
-        if (to.empty()) { return from.size(); }
+        auto value = input.next();
+        if (!value.has_value()) { break; }
+        arguments.push_back(std::move(value.value()));
+    }
+
+    return arguments;
+}
 
-        auto const fromTail = from.substr(1);
-        auto const toTail   = from.substr(1);
+// hands out the first ``count`` values of ``input`` and lets go of it as soon as they are out, which is what stops
+// the stages upstream: their streams are dropped, and with them the rings the pipelined ones write to.
+ballin::Stream take_values(ballin::Stream input, std::size_t const count)
+{
+    return ballin::Stream { [input = std::move(input), remaining = count] (ballin::Batch& output) mutable -> bool {
+        if (remaining == 0) { return false; }
 
-        if (from.front() == to.front())
+        if (!input.next_batch(output))
         {
-            return calculate_edit_distance(fromTail, toTail);
+            remaining = 0;
+            return false;
         }
 
-        return 1 + std::ranges::min({
-                calculate_edit_distance(fromTail, to),
-                calculate_edit_distance(toTail, from),
-                calculate_edit_distance(fromTail, toTail)
-            });
-    }
+        output.truncate(remaining);
+        remaining -= output.size();
 
-    void handle_non_existing_command(auto const& availableCommands, auto const& commandName)
-    {
-        std::print("the command `{}` doesn't exist.", commandName);
+        if (remaining == 0) { input = {}; }
+
+        return true;
+    }};
+}
 
-        auto similarCommands = std::views::keys(availableCommands) | std::views::filter([&] (auto&& value) {
-            auto const distance = calculate_edit_distance(commandName, value);
-            auto const size     = std::ranges::max(commandName.size(), value.size());
+// a command's one result, kept in the scratch memory of the line running it.
+ballin::Command::return_t single_result(std::string value)
+{
+    ballin::Command::return_t results { ballin::memory::line_resource() };
+    results.push_back(std::move(value));
+    return results;
+}
 
-            return  (size - distance) / size * 100 > 70;
-        });
+// the arithmetic commands themselves, both sides having to be numbers.
+auto make_arithmetic_command(auto operation)
+{
+    return [operation] (ballin::Command::arguments_t arguments) -> ballin::Command::return_t {
+        auto const lhs = ballin::io::parse_real(arguments.at(0));
+        auto const rhs = ballin::io::parse_real(arguments.at(1));
 
-        if (similarCommands.empty()) { std::print("\n"); }
-        else
+        if (!lhs.has_value() || !rhs.has_value())
+        {
+            ballin::io::println("{}", lhs.has_value() ? rhs.error() : lhs.error());
+            return {};
+        }
+
+        return single_result(ballin::io::format_real(operation(lhs.value(), rhs.value())));
+    };
+}
+
+// batch kernel of the arithmetic commands, the value being their left hand side.
+auto make_arithmetic_kernel(auto operation)
+{
+    return [operation] (ballin::Command::arguments_t const& arguments, ballin::Batch const& input, ballin::Batch& output) {
+        auto const rhs = ballin::io::parse_real(arguments.at(0));
+
+        // nothing comes out when the right hand side isn't a number, reported for every value as with the command itself.
+        if (!rhs.has_value())
         {
-            std::println(" did you mean:");
+            output.reset(ballin::Batch::Type::REAL);
 
-            for (auto const command : similarCommands)
+            for (auto index = 0zu; index != input.size(); index += 1)
             {
-                std::println("    - {}", command);
+                auto const lhs = input.real(index);
+                ballin::io::println("{}", lhs.has_value() ? rhs.error() : lhs.error());
             }
+
+            return;
         }
-    }
 
-    }
+        ballin::transform_reals(input, output, [&] (float lhs) { return operation(lhs, rhs.value()); });
+    };
+}
 
-class Command
+// program of the arithmetic commands, the value being their left hand side.
+auto make_arithmetic_program(char const operation)
 {
-public:
-    using arguments_t = std::deque<std::string>;
-    using return_t    = std::deque<std::string>;
-    using signature_t = std::function<return_t(arguments_t)>;
-
-    Command() = default;
-
-    Command(std::string_view const commandName, std::size_t const numberOfArguments, signature_t const commandAction):
-        name_m(commandName),
-        expectedNumberOfArguments_m(numberOfArguments),
-        action_m(commandAction)
-    {}
+    return [operation] (ballin::Command::arguments_t const& arguments) -> std::optional<ballin::math::Program> {
+        if (arguments.size() != 1) { return std::nullopt; }
 
-    constexpr auto const& arguments_stack() const { return argumentsStack_m; }
-    constexpr auto const& name() const { return name_m; }
-    constexpr auto const& expected_number_of_arguments() const { return expectedNumberOfArguments_m; }
-    constexpr auto& subcommands() const { return subcommands_m; }
-    constexpr auto& subcommands() { return subcommands_m; }
+        auto const rhs = ballin::io::parse_real(arguments.at(0));
+        if (!rhs.has_value()) { return std::nullopt; }
 
-    auto push_back_argument(std::string_view const argument) { argumentsStack_m.push_back(argument.data()); }
-    auto push_front_argument(std::string_view const argument) { argumentsStack_m.push_front(argument.data()); }
-    auto push_subcommand(Command&& subcommand) { subcommands_m.push_back(subcommand); }
+        return ballin::math::Program::binary(operation, rhs.value());
+    };
+}
 
-    return_t operator()() const
+// runs ``command`` once per value, with the value as its first argument and ``arguments`` as the rest.
+void apply_to_batch(ballin::Command const& command, ballin::Command::arguments_t& arguments, ballin::Batch const& input, ballin::Batch& output)
+{
+    if (command.batch_kernel())
     {
-        return std::invoke(action_m, argumentsStack_m);
+        command.batch_kernel()(arguments, input, output);
+        return;
     }
 
-    return_t operator()(std::deque<std::string> argumentsStack) const
-    {
-        auto localArgumentsStack = argumentsStack_m;
+    output.reset(ballin::Batch::Type::TEXT);
 
-        std::ranges::for_each(argumentsStack, [&] (auto&& argument) {
-            localArgumentsStack.push_back(argument);
-        });
+    for (auto index = 0zu; index != input.size(); index += 1)
+    {
+        arguments.push_front(input.text(index));
+        auto operationResult = command(arguments);
+        arguments.pop_front();
 
-        return std::invoke(action_m, localArgumentsStack);
+        if (!operationResult.empty()) { output.texts().push_back(std::move(operationResult.front())); }
     }
+}
 
-private:
-    std::string name_m {};
-    arguments_t argumentsStack_m {};
-    std::size_t expectedNumberOfArguments_m {};
-    signature_t action_m {};
-    std::vector<Command> subcommands_m {};
-};
-
-class Commands
+ballin::Stream apply_command(ballin::Commands const& commands, ballin::Command::arguments_t arguments, ballin::Stream input, bool const parallel)
 {
-public:
-    constexpr auto contains(std::string_view const commandName) const { return commands_m.contains(commandName.data()); }
+    arguments = take_arguments(std::move(arguments), input, 1);
 
-    std::optional<Command> command(std::string_view const commandName) const
-    {
-        if (commands_m.find(commandName.data()) == commands_m.end())
-        {
-            handle_non_existing_command(commands_m, commandName);
-            return std::nullopt;
-        }
-
-        return commands_m.at(commandName.data());
-    }
+    auto const maybeCommand = commands.command(arguments.at(0));
 
-    void register_command(Command command)
+    if (!maybeCommand.has_value())
     {
-        assert(commands_m.contains(command.name()) != true);
-        commands_m[command.name()] = command;
+        return {};
     }
 
-private:
-    std::unordered_map<std::string, Command> commands_m {};
-};
+    auto requestedCommand          = maybeCommand.value();
+    auto requestedCommandArguments = std::ranges::to<ballin::Command::arguments_t>(arguments | std::views::take(requestedCommand.expected_number_of_arguments()) | std::views::drop(1));
 
-class Interpreter
-{
-public:
-    explicit Interpreter(Commands const& commands):
-        commands_m(commands)
-    {}
+    auto elements = arguments.size() <= requestedCommand.expected_number_of_arguments()
+        ? std::move(input)
+        : ballin::Stream::concat(ballin::Stream::from(std::ranges::to<ballin::Command::arguments_t>(arguments | std::views::drop(requestedCommand.expected_number_of_arguments()))), std::move(input));
 
-    void enqueue_command(std::string_view input)
+    if (parallel)
     {
-        auto commands = input | std::views::split(' ') | std::views::chunk_by([] (auto, auto rhs) { return rhs.front() != '|'; });
-
-        auto fnParseCommand = [this] (auto input) -> std::optional<Command> {
-            auto view            = input | std::views::drop_while([] (auto value) { return value.front()  == '|'; });
-            auto const name      = std::ranges::to<std::string>(view.front());
-            auto const arguments = std::ranges::to<std::vector<std::string>>(view | std::views::drop(1));
+        // batches are taken a round at a time, every worker gets its own copy of the arguments and the
+        // results are handed out in the order their inputs came in.
+        auto const batchesPerRound = 4 * ballin::parallel::Scheduler::global().number_of_workers();
+
+        return ballin::Stream {
+            [requestedCommand = std::move(requestedCommand), requestedCommandArguments = std::move(requestedCommandArguments), elements = std::move(elements),
+             inputs = std::vector<ballin::Batch>(batchesPerRound), outputs = std::vector<ballin::Batch>(batchesPerRound), numberOfBatches = 0zu, nextBatch = 0zu] (ballin::Batch& output) mutable -> bool {
+                while (true)
+                {
+                    while (nextBatch != numberOfBatches)
+                    {
+                        std::swap(output, outputs[nextBatch++]);
+                        if (!output.empty()) { return true; }
+                    }
 
-            auto maybeCommand = commands_m.command(name);
+                    for (numberOfBatches = 0, nextBatch = 0; numberOfBatches != inputs.size() && elements.next_batch(inputs[numberOfBatches]); numberOfBatches += 1) {}
 
-            if (!maybeCommand.has_value()) { return std::nullopt; }
+                    if (numberOfBatches == 0) { return false; }
 
-            for (auto const& argument : arguments)
-            {
-                maybeCommand.value().push_back_argument(argument);
+                    ballin::parallel::parallel_for(0, numberOfBatches, 1, [&] (std::size_t const index) {
+                        auto localArguments = requestedCommandArguments;
+                        apply_to_batch(requestedCommand, localArguments, inputs[index], outputs[index]);
+                    });
+                }
             }
+        };
+    }
 
-            return maybeCommand.value();
+    if (requestedCommand.batch_kernel())
+    {
+        return ballin::Stream {
+            [requestedCommand = std::move(requestedCommand), requestedCommandArguments = std::move(requestedCommandArguments), elements = std::move(elements), batch = ballin::Batch {}] (ballin::Batch& output) mutable -> bool {
+                while (elements.next_batch(batch))
+                {
+                    apply_to_batch(requestedCommand, requestedCommandArguments, batch, output);
+                    if (!output.empty()) { return true; }
+                }
+
+                return false;
+            }
         };
+    }
 
-        auto masterCommand = fnParseCommand(commands.front());
+    return ballin::Stream {
+        [requestedCommand = std::move(requestedCommand), requestedCommandArguments = std::move(requestedCommandArguments), elements = std::move(elements)] () mutable -> std::optional<std::string> {
+            while (auto element = elements.next())
+            {
+                requestedCommandArguments.push_front(element.value());
+                auto operationResult = requestedCommand(requestedCommandArguments);
+                requestedCommandArguments.pop_front();
 
-        if (!masterCommand.has_value()) { return; }
+                if (!operationResult.empty()) { return operationResult.front(); }
+            }
 
-        for (auto const& view : commands | std::views::drop(1))
-        {
-            auto subcommand = fnParseCommand(view);
-            if (!subcommand.has_value()) { return; }
-            masterCommand.value().push_subcommand(std::move(subcommand.value()));
+            return std::nullopt;
         }
+    };
+}
 
-        queuedCommands_m.push(masterCommand.value());
-    }
+// writes out every value of ``input``, each one after a ``separator``. values are formatted a round of batches
+// at a time, every batch into its own buffer on a worker, and the buffers are written out in order.
+void write_values(ballin::Stream& input, std::string_view separator)
+{
+    auto const batchesPerRound = 4 * ballin::parallel::Scheduler::global().number_of_workers();
+
+    std::vector<ballin::Batch> batches(batchesPerRound);
+    std::vector<std::string> buffers(batchesPerRound);
 
-    void execute()
+    while (true)
     {
-        while (!queuedCommands_m.empty())
-        {
-            auto const& masterCommand = queuedCommands_m.front();
-            auto operationResult = masterCommand();
+        auto numberOfBatches = 0zu;
+        for (; numberOfBatches != batches.size() && input.next_batch(batches[numberOfBatches]); numberOfBatches += 1) {}
+
+        if (numberOfBatches == 0) { return; }
+
+        ballin::parallel::parallel_for(0, numberOfBatches, 1, [&] (std::size_t const index) {
+            auto const& batch = batches[index];
+            auto& buffer      = buffers[index];
+
+            buffer.clear();
 
-            for (auto const& subcommand : masterCommand.subcommands())
+            for (auto valueIndex = 0zu; valueIndex != batch.size(); valueIndex += 1)
             {
-                operationResult = subcommand(operationResult);
+                buffer.push_back(' ');
+                batch.append_text(valueIndex, buffer);
             }
+        });
+
+        for (auto const& buffer : buffers | std::views::take(numberOfBatches))
+        {
+            if (buffer.empty()) { continue; }
 
-            queuedCommands_m.pop();
+            // every value was formatted after a single space, the very first one may not want it.
+            ballin::io::write(separator);
+            ballin::io::write(std::string_view { buffer }.substr(1));
+            separator = " ";
         }
     }
+}
+
+// takes the next line off the front of ``script``, ``\r\n`` line endings included.
+std::optional<std::string_view> next_line(std::string_view& script)
+{
+    if (script.empty()) { return std::nullopt; }
+
+    auto const lineEnd = std::min(script.find('\n'), script.size());
+    auto line          = script.substr(0, lineEnd);
+
+    script.remove_prefix(std::min(lineEnd + 1, script.size()));
+
+    if (line.ends_with('\r')) { line.remove_suffix(1); }
 
-private:
-    std::queue<Command> queuedCommands_m {};
-    Commands const& commands_m;
-};
+    return line;
+}
 
 }
 
-auto register_commands(ballin::Commands& commands)
+auto register_commands(ballin::Commands& commands, ballin::plugin::Loader& pluginLoader)
 {
     using arguments_t = ballin::Command::arguments_t;
     using return_t    = ballin::Command::return_t;
 
-    commands.register_command(ballin::Command
+    // every builtin goes into the registry in one snapshot, copying it once rather than once per command.
+    std::vector<ballin::Command> builtinCommands {};
+
+    builtinCommands.push_back(ballin::Command
     {
         "quit", 0, [] (arguments_t) -> return_t {
             std::exit(EXIT_SUCCESS);
             return {};
         }
-    });
+    }.with_effect(ballin::Command::Effect::BARRIER));
 
-    commands.register_command(ballin::Command
+    builtinCommands.push_back(ballin::Command
+    {
+        "echo", 1, [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            return ballin::Stream { [arguments = std::move(arguments), input = std::move(input)] () mutable -> std::optional<std::string> {
+                auto separator = std::string_view {};
+
+                for (auto const& argument : arguments)
+                {
+                    ballin::io::print("{}{}", separator, argument);
+                    separator = " ";
+                }
+
+                write_values(input, separator);
+
+                ballin::io::print("\n");
+
+                return std::nullopt;
+            }};
+        }
+    }.with_effect(ballin::Command::Effect::OUTPUT));
+
+    builtinCommands.push_back(ballin::Command
     {
-        "echo", 1, [] (arguments_t arguments) -> return_t {
-            std::println("{}", std::ranges::to<std::string>(arguments | std::views::join_with(' ')));
+        "reload", std::numeric_limits<std::size_t>::max(), [&] (arguments_t arguments) -> return_t {
+            auto const moduleNames = arguments.empty() ? pluginLoader.module_names() : std::ranges::to<std::vector>(arguments);
+
+            for (auto const& moduleName : moduleNames)
+            {
+                if (auto const result = pluginLoader.reload(moduleName); result.has_value())
+                {
+                    ballin::io::println("reloaded `{}` ({} commands).", moduleName, result.value());
+                }
+                else
+                {
+                    ballin::io::println("{}", result.error());
+                }
+            }
+
             return {};
         }
+    }.with_effect(ballin::Command::Effect::BARRIER));
+
+    builtinCommands.push_back(ballin::Command
+    {
+        "complete", 1, [&] (arguments_t arguments) -> return_t {
+            return std::ranges::to<ballin::Command::return_t>(commands.completions(arguments.empty() ? "" : arguments.at(0)));
+        }
     });
 
-    commands.register_command(ballin::Command
+    builtinCommands.push_back(ballin::Command
+    {
+        "add", 2,
+        make_arithmetic_command(std::plus {}),
+        make_arithmetic_kernel(std::plus {}),
+        make_arithmetic_program('+')
+    });
+
+    builtinCommands.push_back(ballin::Command
+    {
+        "sub", 2,
+        make_arithmetic_command(std::minus {}),
+        make_arithmetic_kernel(std::minus {}),
+        make_arithmetic_program('-')
+    });
+
+    builtinCommands.push_back(ballin::Command
+    {
+        "mul", 2,
+        make_arithmetic_command(std::multiplies {}),
+        make_arithmetic_kernel(std::multiplies {}),
+        make_arithmetic_program('*')
+    });
+
+    builtinCommands.push_back(ballin::Command
     {
-        "add", 2, [] (arguments_t arguments) -> return_t {
-            float lhs {};
-            std::stringstream { arguments.at(0) } >> lhs;
-            float rhs {};
-            std::stringstream { arguments.at(1) } >> rhs;
+        "div", 2,
+        make_arithmetic_command(std::divides {}),
+        make_arithmetic_kernel(std::divides {}),
+        make_arithmetic_program('/')
+    });
 
-            std::stringstream stream {};
-            stream << (lhs + rhs);
+    builtinCommands.push_back(ballin::Command
+    {
+        "pow", 2,
+        make_arithmetic_command([] (float lhs, float rhs) { return std::pow(lhs, rhs); }),
+        make_arithmetic_kernel([] (float lhs, float rhs) { return std::pow(lhs, rhs); }),
+        make_arithmetic_program('^')
+    });
 
-            return { stream.str() };
+    builtinCommands.push_back(ballin::Command
+    {
+        "eval", 1, [] (arguments_t arguments) -> return_t {
+            auto const expression = std::ranges::to<std::string>(arguments | std::views::join_with(' '));
+
+            ballin::math::Lexer expressionLexer { expression };
+
+            auto const parsedExpression = ballin::math::parse_expression(expressionLexer.tokenize());
+
+            auto const value = ballin::math::evaluate_expression(parsedExpression);
+
+            if (!value.has_value())
+            {
+                ballin::io::println("{}", value.error());
+                return {};
+            }
+
+            return single_result(ballin::io::format_real(value.value()));
+        },
+        [] (arguments_t const& arguments, ballin::Batch const& input, ballin::Batch& output) {
+            auto const expression = std::ranges::to<std::string>(arguments | std::views::join_with(' '));
+
+            ballin::math::Lexer expressionLexer { expression };
+
+            // the value goes in front of the rest of the expression, parse it once for the whole batch.
+            auto tokens = expressionLexer.tokenize();
+            tokens.insert(tokens.begin(), { ballin::math::Token::Type::VARIABLE, ballin::math::Token::Precedence::NONE, ballin::math::Token::Fixity::LEFT, {} });
+
+            auto const parsedExpression = ballin::math::parse_expression(tokens);
+
+            std::vector<float> variables {};
+            variables.reserve(input.size());
+
+            for (auto index = 0zu; index != input.size(); index += 1)
+            {
+                auto const value = input.real(index);
+
+                if (!value.has_value())
+                {
+                    ballin::io::println("{}", value.error());
+                    continue;
+                }
+
+                variables.push_back(value.value());
+            }
+
+            output.reset(ballin::Batch::Type::REAL);
+            output.reals().resize(variables.size());
+
+            if (!ballin::math::evaluate_expression(parsedExpression, variables, output.reals())) { output.reals().clear(); }
+        },
+        [] (arguments_t const& arguments) -> std::optional<ballin::math::Program> {
+            auto const expression = std::ranges::to<std::string>(arguments | std::views::join_with(' '));
+
+            ballin::math::Lexer expressionLexer { expression };
+
+            auto tokens = expressionLexer.tokenize();
+            tokens.insert(tokens.begin(), { ballin::math::Token::Type::VARIABLE, ballin::math::Token::Precedence::NONE, ballin::math::Token::Fixity::LEFT, {} });
+
+            return ballin::math::Program::compile(ballin::math::parse_expression(tokens));
         }
     });
 
-    commands.register_command(ballin::Command
+    builtinCommands.push_back(ballin::Command
     {
-        "sub", 2, [] (arguments_t arguments) -> return_t {
-            float lhs {};
-            std::stringstream { arguments.at(0) } >> lhs;
-            float rhs {};
-            std::stringstream { arguments.at(1) } >> rhs;
+        "hex", 1, [] (arguments_t arguments) -> return_t {
+            auto const value = ballin::io::parse_integer(arguments.at(0));
+
+            if (!value.has_value())
+            {
+                ballin::io::println("{}", value.error());
+                return {};
+            }
+
+            return single_result("0x" + ballin::io::format_integer(value.value(), 16));
+        },
+        [] (arguments_t const&, ballin::Batch const& input, ballin::Batch& output) {
+            output.reset(ballin::Batch::Type::TEXT);
+
+            for (auto index = 0zu; index != input.size(); index += 1)
+            {
+                auto const value = input.integer(index);
 
-            std::stringstream stream {};
-            stream << (lhs - rhs);
+                if (!value.has_value())
+                {
+                    ballin::io::println("{}", value.error());
+                    continue;
+                }
 
-            return { stream.str() };
+                auto& text = output.texts().emplace_back("0x");
+                ballin::io::append_integer(text, value.value(), 16);
+            }
         }
     });
 
-    commands.register_command(ballin::Command
+    builtinCommands.push_back(ballin::Command
     {
-        "mul", 2, [] (arguments_t arguments) -> return_t {
-            float lhs {};
-            std::stringstream { arguments.at(0) } >> lhs;
-            float rhs {};
-            std::stringstream { arguments.at(1) } >> rhs;
+        "bin", 1, [] (arguments_t arguments) -> return_t {
+            auto const maybeValue = ballin::io::parse_integer(arguments.at(0));
+
+            if (!maybeValue.has_value())
+            {
+                ballin::io::println("{}", maybeValue.error());
+                return {};
+            }
 
-            std::stringstream stream {};
-            stream << (lhs * rhs);
+            auto const value = maybeValue.value();
 
-            return { stream.str() };
+            if (value <= std::numeric_limits<std::uint8_t>::max()) { return single_result("0b" + std::bitset<8>(value).to_string()); }
+            else if (value <= std::numeric_limits<std::uint16_t>::max()) { return single_result("0b" + std::bitset<16>(value).to_string()); }
+            else if (value <= std::numeric_limits<std::uint32_t>::max()) { return single_result("0b" + std::bitset<32>(value).to_string()); }
+            else if (value <= std::numeric_limits<std::uint64_t>::max()) { return single_result("0b" + std::bitset<64>(value).to_string()); }
+
+            std::unreachable();
         }
     });
 
-    commands.register_command(ballin::Command
+    builtinCommands.push_back(ballin::Command
     {
-        "div", 2, [] (arguments_t arguments) -> return_t {
-            float lhs {};
-            std::stringstream { arguments.at(0) } >> lhs;
-            float rhs {};
-            std::stringstream { arguments.at(1) } >> rhs;
+        "iota", 2, [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            arguments = take_arguments(std::move(arguments), input, 2);
+
+            auto const minimum = ballin::io::parse_integer(arguments.at(0));
+            auto const maximum = ballin::io::parse_integer(arguments.at(1));
+
+            if (!minimum.has_value() || !maximum.has_value())
+            {
+                ballin::io::println("{}", minimum.has_value() ? maximum.error() : minimum.error());
+                return {};
+            }
+
+            return ballin::Stream { [index = minimum.value(), maximum = maximum.value()] (ballin::Batch& batch) mutable -> bool {
+                batch.reset(ballin::Batch::Type::INTEGER);
+
+                auto& values = batch.integers();
 
-            std::stringstream stream {};
-            stream << (lhs / rhs);
+                while (index <= maximum && values.size() != ballin::Batch::CAPACITY)
+                {
+                    values.push_back(index);
+                    index += 1;
+                }
 
-            return { stream.str() };
+                return !values.empty();
+            }};
         }
     });
 
-    commands.register_command(ballin::Command
+    builtinCommands.push_back(ballin::Command
     {
-        "pow", 2, [] (arguments_t arguments) -> return_t {
-            float lhs {};
-            std::stringstream { arguments.at(0) } >> lhs;
-            float rhs {};
-            std::stringstream { arguments.at(1) } >> rhs;
+        "take", 1, [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            arguments = take_arguments(std::move(arguments), input, 1);
 
-            std::stringstream stream {};
-            stream << std::pow(lhs, rhs);
+            auto const count = ballin::io::parse_integer(arguments.at(0));
+
+            if (!count.has_value())
+            {
+                ballin::io::println("{}", count.error());
+                return {};
+            }
 
-            return { stream.str() };
+            return take_values(std::move(input), count.value());
         }
     });
 
-    commands.register_command(ballin::Command
+    // like ``take``, with the count being optional.
+    builtinCommands.push_back(ballin::Command
     {
-        "eval", 1, [] (arguments_t arguments) -> return_t {
-            auto const expression = std::ranges::to<std::string>(arguments | std::views::join_with(' '));
+        "head", 1, [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            constexpr std::size_t DEFAULT_COUNT = 10;
 
-            ballin::math::Lexer expressionLexer { expression };
+            auto const count = arguments.empty() ? std::expected<std::size_t, std::string> { DEFAULT_COUNT } : ballin::io::parse_integer(arguments.at(0));
 
-            auto const parsedExpression = ballin::math::parse_expression(expressionLexer.tokenize());
+            if (!count.has_value())
+            {
+                ballin::io::println("{}", count.error());
+                return {};
+            }
 
-            std::stringstream stream {};
-            stream << ballin::math::evaluate_expression(parsedExpression);
+            return take_values(std::move(input), count.value());
+        }
+    });
 
-            return { stream.str() };
+    builtinCommands.push_back(ballin::Command
+    {
+        "first", 0, [] (arguments_t, ballin::Stream input) -> ballin::Stream {
+            return take_values(std::move(input), 1);
         }
     });
 
-    commands.register_command(ballin::Command
+    // the first value that reads the same as the argument, nothing if none does.
+    builtinCommands.push_back(ballin::Command
     {
-        "hex", 1, [] (arguments_t arguments) -> return_t {
-            std::size_t value {};
-            std::stringstream { arguments.at(0) } >> value;
+        "find", 1, [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            arguments = take_arguments(std::move(arguments), input, 1);
 
-            std::stringstream stream {};
-            stream << std::hex << value;
+            return ballin::Stream { [value = std::move(arguments.at(0)), input = std::move(input), batch = ballin::Batch {}] () mutable -> std::optional<std::string> {
+                while (input.next_batch(batch))
+                {
+                    for (auto index = 0zu; index != batch.size(); index += 1)
+                    {
+                        if (batch.text(index) != value) { continue; }
+
+                        input = {};
 
-            return { "0x" + stream.str() };
+                        return value;
+                    }
+                }
+
+                return std::nullopt;
+            }};
         }
     });
 
-    commands.register_command(ballin::Command
+    builtinCommands.push_back(ballin::Command
     {
-        "bin", 1, [] (arguments_t arguments) -> return_t {
-            std::size_t value {};
-            std::stringstream { arguments.at(0) } >> value;
+        "apply", std::numeric_limits<std::size_t>::max(), [&] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            return apply_command(commands, std::move(arguments), std::move(input), false);
+        },
+        [&] (arguments_t const& arguments) -> std::optional<ballin::math::Program> {
+            if (arguments.empty() || !commands.contains(arguments.at(0))) { return std::nullopt; }
 
-            if (value <= std::numeric_limits<std::uint8_t>::max()) { return { "0b" + std::bitset<8>(value).to_string() }; }
-            else if (value <= std::numeric_limits<std::uint16_t>::max()) { return { "0b" + std::bitset<16>(value).to_string() }; }
-            else if (value <= std::numeric_limits<std::uint32_t>::max()) { return { "0b" + std::bitset<32>(value).to_string() }; }
-            else if (value <= std::numeric_limits<std::uint64_t>::max()) { return { "0b" + std::bitset<64>(value).to_string() }; }
+            auto const requestedCommand = commands.command(arguments.at(0)).value();
 
-            std::unreachable();
+            // only when every value comes from the previous stage, neither missing arguments nor carrying values of its own.
+            if (arguments.size() != requestedCommand.expected_number_of_arguments()) { return std::nullopt; }
+
+            return requestedCommand.program(std::ranges::to<ballin::Command::arguments_t>(arguments | std::views::drop(1)));
         }
-    });
+    }.with_effect(ballin::Command::Effect::OF_TARGET));
 
-    commands.register_command(ballin::Command
+    // like ``apply``, spreading the values across threads. meant for commands without side effects.
+    builtinCommands.push_back(ballin::Command
     {
-        "iota", 2, [] (arguments_t arguments) -> return_t {
-            std::size_t minimum {};
-            std::stringstream { arguments.at(0) } >> minimum;
-            std::size_t maximum {};
-            std::stringstream { arguments.at(1) } >> maximum;
+        "papply", std::numeric_limits<std::size_t>::max(), [&] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            return apply_command(commands, std::move(arguments), std::move(input), true);
+        }
+    }.with_effect(ballin::Command::Effect::OF_TARGET));
+
+    // the values of a column of a file, see ``io::load_columns``.
+    builtinCommands.push_back(ballin::Command
+    {
+        "load", 2, [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            arguments = take_arguments(std::move(arguments), input, 1);
 
-            std::deque<std::string> result {};
+            auto values = ballin::io::load_columns(arguments.at(0), arguments.size() > 1 ? std::optional<std::string_view> { arguments.at(1) } : std::nullopt);
 
-            for (auto index : std::views::iota(minimum, maximum + 1))
+            if (!values.has_value())
             {
-                std::stringstream stream {};
-                stream << index;
-                result.push_back(stream.str());
+                ballin::io::println("{}", values.error());
+                return {};
             }
 
-            return result;
+            return std::move(values.value());
         }
     });
 
-    commands.register_command(ballin::Command
+    // keeps the values it is given on disk under a name, for ``fetch`` to stream them back later on.
+    builtinCommands.push_back(ballin::Command
     {
-        "apply", std::numeric_limits<std::size_t>::max(), [&] (arguments_t arguments) -> return_t {
-            auto const maybeCommand = commands.command(arguments.at(0));
+        "store", 1, [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            arguments = take_arguments(std::move(arguments), input, 1);
 
-            if (!maybeCommand.has_value())
+            if (auto const stored = ballin::io::store_column(arguments.at(0), std::move(input)); !stored.has_value())
             {
-                return {};
+                ballin::io::println("{}", stored.error());
             }
 
-            auto requestedCommand          = maybeCommand.value();
-            auto requestedCommandArguments = std::ranges::to<std::deque>(arguments | std::views::take(requestedCommand.expected_number_of_arguments()) | std::views::drop(1));
+            return {};
+        }
+    }.with_effect(ballin::Command::Effect::BARRIER));
+
+    builtinCommands.push_back(ballin::Command
+    {
+        "fetch", 1, [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            arguments = take_arguments(std::move(arguments), input, 1);
 
-            std::deque<std::string> result {};
+            auto values = ballin::io::fetch_column(arguments.at(0));
 
-            for (auto const& argument : arguments | std::views::drop(requestedCommand.expected_number_of_arguments()))
+            if (!values.has_value())
             {
-                requestedCommandArguments.push_front(argument);
+                ballin::io::println("{}", values.error());
+                return {};
+            }
+
+            return std::move(values.value());
+        }
+    });
 
-                if (auto operationResult = requestedCommand(requestedCommandArguments); !operationResult.empty())
+    // every value, and every argument, is read as a text full of whitespace separated numbers.
+    builtinCommands.push_back(ballin::Command
+    {
+        "parse", std::numeric_limits<std::size_t>::max(), [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            auto texts = ballin::Stream::concat(ballin::Stream::from(std::move(arguments)), std::move(input));
+
+            return ballin::Stream { [texts = std::move(texts), text = std::string {}, position = 0zu] (ballin::Batch& batch) mutable -> bool {
+                while (!ballin::io::scan_numbers(text, position, batch))
                 {
-                    result.push_back(operationResult.front());
+                    auto nextText = texts.next();
+                    if (!nextText.has_value()) { return false; }
+
+                    text     = std::move(nextText.value());
+                    position = 0;
                 }
 
-                requestedCommandArguments.pop_front();
+                return true;
+            }};
+        }
+    });
+
+    builtinCommands.push_back(ballin::Command
+    {
+        "sum", std::numeric_limits<std::size_t>::max(), [] (arguments_t arguments, ballin::Stream input) -> ballin::Stream {
+            auto values = ballin::Stream::concat(ballin::Stream::from(std::move(arguments)), std::move(input));
+
+            auto const batchesPerRound = 4 * ballin::parallel::Scheduler::global().number_of_workers();
+
+            std::vector<ballin::Batch> batches(batchesPerRound);
+            double sum {};
+
+            while (true)
+            {
+                auto numberOfBatches = 0zu;
+                for (; numberOfBatches != batches.size() && values.next_batch(batches[numberOfBatches]); numberOfBatches += 1) {}
+
+                if (numberOfBatches == 0) { break; }
+
+                sum += ballin::parallel::parallel_reduce(0, numberOfBatches, 1, 0.0, [&] (std::size_t const index) {
+                    auto batchSum = 0.0;
+                    for (auto valueIndex = 0zu; valueIndex != batches[index].size(); valueIndex += 1)
+                    {
+                        auto const value = batches[index].real(valueIndex);
+
+                        if (!value.has_value())
+                        {
+                            ballin::io::println("{}", value.error());
+                            continue;
+                        }
+
+                        batchSum += static_cast<double>(value.value());
+                    }
+
+                    return batchSum;
+                }, std::plus {});
             }
 
-            return result;
+            return ballin::Stream::from({ ballin::io::format_real(static_cast<float>(sum)) });
         }
     });
+
+    commands.register_commands(std::move(builtinCommands));
 }
 
-int main()
+int main(int argc, char const** argv)
 {
     ballin::Commands commands {};
-    register_commands(commands);
+    ballin::plugin::Loader pluginLoader { commands };
+    register_commands(commands, pluginLoader);
 
     ballin::Interpreter interpreter { commands };
 
-    std::println("ballin interpreter v0.4.2.0");
+    commands.register_command(ballin::Command
+    {
+        "cache", 0, [&] (ballin::Command::arguments_t) -> ballin::Command::return_t {
+            auto const [lineHits, templateHits, misses] = interpreter.cache_statistics();
+            auto const lookups = lineHits + templateHits + misses;
+
+            ballin::io::println("{} lookups, {} line hits, {} template hits, {} misses ({:.1f}% hit rate).",
+                lookups, lineHits, templateHits, misses, lookups == 0 ? 0.0 : 100.0 * static_cast<double>(lineHits + templateHits) / static_cast<double>(lookups));
 
-    while (true)
+            return {};
+        }
+    }.with_effect(ballin::Command::Effect::BARRIER));
+
+    auto schedulerOptions = ballin::parallel::Scheduler::default_options();
+    auto countAllocations = false;
+    std::optional<ballin::io::Sink::FlushPolicy> flushPolicy {};
+    auto overlapped       = false;
+    auto concurrent       = false;
+
+    std::vector<std::string_view> pluginDirectories {};
+    std::optional<std::string_view> scriptPath {};
+
+    auto const arguments = std::span { argv, static_cast<std::size_t>(argc) } | std::views::drop(1);
+
+    for (auto argument = arguments.begin(); argument != arguments.end(); ++argument)
     {
-        std::string input {};
-        std::print(">> ");
-        std::getline(std::cin, input);
+        if (std::string_view { *argument } == "--plugins" && std::next(argument) != arguments.end())
+        {
+            pluginDirectories.push_back(*++argument);
+        }
+        else if (std::string_view { *argument } == "--script" && std::next(argument) != arguments.end())
+        {
+            scriptPath = *++argument;
+        }
+        else if (std::string_view { *argument } == "--overlapped")
+        {
+            overlapped = true;
+        }
+        else if (std::string_view { *argument } == "--concurrent")
+        {
+            concurrent = true;
+        }
+        else if (std::string_view { *argument } == "--pipelined")
+        {
+            interpreter.set_execution_mode(ballin::Interpreter::ExecutionMode::PIPELINED);
+        }
+        else if (std::string_view { *argument } == "--threads" && std::next(argument) != arguments.end() && ballin::io::parse_integer(*std::next(argument)).has_value())
+        {
+            schedulerOptions.numberOfWorkers = ballin::io::parse_integer(*++argument).value();
+        }
+        else if (std::string_view { *argument } == "--pin-threads")
+        {
+            schedulerOptions.pinWorkers = true;
+        }
+        else if (std::string_view { *argument } == "--count-allocations")
+        {
+            countAllocations = true;
+        }
+        else if (std::string_view { *argument } == "--flush" && std::next(argument) != arguments.end() && (std::string_view { *std::next(argument) } == "line" || std::string_view { *std::next(argument) } == "full"))
+        {
+            flushPolicy = std::string_view { *++argument } == "line" ? ballin::io::Sink::FlushPolicy::LINE : ballin::io::Sink::FlushPolicy::FULL;
+        }
+        else
+        {
+            std::println("usage: ballin [--script <file>] [--overlapped] [--concurrent] [--plugins <directory>] [--pipelined] [--threads <count>] [--pin-threads] [--count-allocations] [--flush <line|full>]");
+            return EXIT_FAILURE;
+        }
+    }
+
+    // scripts and piped input run without prompts, and their output is only written out once a large buffer fills up.
+    auto const isInteractive = !scriptPath.has_value() && isatty(STDIN_FILENO);
+
+    ballin::io::Sink::configure({
+        .bufferSize  = isInteractive ? ballin::io::Sink::default_options().bufferSize : BATCH_OUTPUT_BUFFER_SIZE,
+        .flushPolicy = flushPolicy.value_or(isInteractive ? ballin::io::Sink::FlushPolicy::LINE : ballin::io::Sink::FlushPolicy::FULL)
+    });
+
+    for (auto const& pluginDirectory : pluginDirectories)
+    {
+        pluginLoader.load_directory(pluginDirectory);
+    }
+
+    ballin::parallel::Scheduler::configure(schedulerOptions);
+
+    auto fnRunLine = [&] (std::string_view const line, ballin::Parser::Line const* preparedLine) {
+        auto const allocationCount = ballin::memory::allocation_count();
+
+        // lines parsed ahead that turned out to have errors are parsed again here, so that the errors are reported
+        // in order, and so are lines parsed before the registry changed under them.
+        if (preparedLine != nullptr && preparedLine->type != ballin::Parser::Line::Type::UNPARSED && !interpreter.is_stale(*preparedLine))
+        {
+            interpreter.enqueue_command(*preparedLine);
+        }
+        else
+        {
+            interpreter.enqueue_command(line);
+        }
 
-        interpreter.enqueue_command(input);
         interpreter.execute();
+        ballin::io::Sink::standard_output().end_line();
+
+        if (countAllocations)
+        {
+            std::println(stderr, "{} allocations", ballin::memory::allocation_count() - allocationCount);
+        }
+    };
+
+    if (!isInteractive)
+    {
+        auto mappedScript = scriptPath.has_value() ? ballin::io::MappedFile::open(scriptPath.value()) : ballin::io::MappedFile::open(STDIN_FILENO);
+
+        if (!mappedScript.has_value() && scriptPath.has_value())
+        {
+            std::println("{}", mappedScript.error());
+            return EXIT_FAILURE;
+        }
+
+        // lines come straight off the mapping, unless stdin is a pipe or some other stream that can't be mapped.
+        auto fnReadLine = [&, script = mappedScript.has_value() ? mappedScript.value().contents() : std::string_view {}, line = std::string {}] () mutable -> std::optional<std::string_view> {
+            if (mappedScript.has_value()) { return next_line(script); }
+
+            if (!std::getline(std::cin, line)) { return std::nullopt; }
+            if (line.ends_with('\r')) { line.pop_back(); }
+
+            return line;
+        };
+
+        if (concurrent)
+        {
+            ballin::ScriptRunner { interpreter }.run(std::move(fnReadLine));
+            return EXIT_SUCCESS;
+        }
+
+        if (overlapped)
+        {
+            // lines are read and tokenized on one thread, parsed on another and run on this one.
+            ballin::parallel::overlap(
+                [&, tokenizer = ballin::Tokenizer {}] () mutable -> std::optional<ballin::TokenizedLine> {
+                    auto const line = fnReadLine();
+                    if (!line.has_value()) { return std::nullopt; }
+                    return ballin::TokenizedLine { tokenizer, line.value() };
+                },
+                [&] (ballin::TokenizedLine const& line) { return interpreter.prepare_command(line); },
+                [&] (ballin::TokenizedLine const& line, ballin::Parser::Line const& preparedLine) { fnRunLine(line.text(), &preparedLine); }
+            );
+
+            return EXIT_SUCCESS;
+        }
+
+        while (auto const line = fnReadLine()) { fnRunLine(line.value(), nullptr); }
+
+        return EXIT_SUCCESS;
+    }
+
+    ballin::repl::LineEditor lineEditor { [&] (std::string_view input) { return interpreter.complete(input); } };
+
+    ballin::io::println("ballin interpreter v0.4.2.0");
+
+    while (true)
+    {
+        // the prompt is written straight to the terminal, so whatever is still buffered has to go out before it.
+        ballin::io::Sink::standard_output().flush();
+
+        auto const input = lineEditor.read_line(">> ");
+
+        if (!input.has_value()) { break; }
+
+        fnRunLine(input.value(), nullptr);
     }
 }
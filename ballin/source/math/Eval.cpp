@@ -1,5 +1,9 @@
 #include "math/Eval.hpp"
 
+#include "io/NumericCodec.hpp"
+#include "io/Output.hpp"
+#include "math/Program.hpp"
+
 #include <algorithm>
 #include <cassert>
 #include <deque>
@@ -23,7 +27,8 @@ std::vector<Token> parse_expression(std::vector<Token> const& tokens)
     {
         switch (token.type)
         {
-        case Token::Type::NUMBER: {
+        case Token::Type::NUMBER:
+        case Token::Type::VARIABLE: {
             expression.push_back(token);
             break;
         }
@@ -71,7 +76,7 @@ std::vector<Token> parse_expression(std::vector<Token> const& tokens)
     return expression;
 }
 
-float evaluate_expression(std::vector<Token> const& tokens)
+std::expected<float, std::string> evaluate_expression(std::vector<Token> const& tokens)
 {
     std::stack<float> expressionStack {};
 
@@ -80,13 +85,16 @@ float evaluate_expression(std::vector<Token> const& tokens)
         switch (token.type)
         {
         case Token::Type::NUMBER: {
-            float number {};
-            std::stringstream { token.value } >> number;
-            expressionStack.push(number);
+            // the lexer takes any run of digits and dots for a number, which doesn't make it one.
+            auto const number = io::parse_real(token.value);
+            if (!number.has_value()) { return std::unexpected(number.error()); }
+            expressionStack.push(number.value());
 
             break;
         }
         case Token::Type::OPERATOR: {
+            if (expressionStack.size() < 2) { return std::unexpected(std::string { "the expression is malformed." }); }
+
             float lhs = expressionStack.top();
             expressionStack.pop();
             float rhs = expressionStack.top();
@@ -111,8 +119,24 @@ float evaluate_expression(std::vector<Token> const& tokens)
         }
     }
 
+    if (expressionStack.size() != 1) { return std::unexpected(std::string { "the expression is malformed." }); }
+
     return expressionStack.top();
 }
 
+bool evaluate_expression(std::vector<Token> const& tokens, std::span<float const> variables, std::span<float> results)
+{
+    auto const program = Program::compile(tokens);
+
+    if (!program.has_value())
+    {
+        io::println("the expression is malformed.");
+        return false;
+    }
+
+    program.value().evaluate(variables, results);
+
+    return true;
 }
 
+}
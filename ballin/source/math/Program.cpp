@@ -0,0 +1,141 @@
+#include "math/Program.hpp"
+
+#include "io/NumericCodec.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace ballin::math {
+
+bool Program::push(Instruction const instruction)
+{
+    switch (instruction.type)
+    {
+    case Instruction::Type::NUMBER:
+    case Instruction::Type::VARIABLE: {
+        if (stackDepth_m == MAXIMUM_STACK_DEPTH) { return false; }
+        stackDepth_m += 1;
+        break;
+    }
+    case Instruction::Type::OPERATOR: {
+        if (stackDepth_m < 2) { return false; }
+        stackDepth_m -= 1;
+        break;
+    }
+    case Instruction::Type::STORE_VARIABLE: {
+        if (stackDepth_m < 1) { return false; }
+        stackDepth_m -= 1;
+        break;
+    }
+    }
+
+    maximumStackDepth_m = std::max(maximumStackDepth_m, stackDepth_m);
+    instructions_m.push_back(instruction);
+
+    return true;
+}
+
+std::optional<Program> Program::compile(std::vector<Token> const& tokens)
+{
+    Program program {};
+
+    for (auto const& token : tokens)
+    {
+        auto isValid = true;
+
+        switch (token.type)
+        {
+        case Token::Type::NUMBER: {
+            auto const number = io::parse_real(token.value);
+            isValid = number.has_value() && program.push({ Instruction::Type::NUMBER, {}, number.value() });
+            break;
+        }
+        case Token::Type::VARIABLE: {
+            isValid = program.push({ Instruction::Type::VARIABLE, {}, {} });
+            break;
+        }
+        case Token::Type::OPERATOR: {
+            isValid = program.push({ Instruction::Type::OPERATOR, token.value.front(), {} });
+            break;
+        }
+        case Token::Type::LPAREN: break;
+        case Token::Type::RPAREN: break;
+        }
+
+        if (!isValid) { return std::nullopt; }
+    }
+
+    if (program.stackDepth_m != 1) { return std::nullopt; }
+
+    return program;
+}
+
+Program Program::binary(char const operation, float const operand)
+{
+    Program program {};
+
+    program.push({ Instruction::Type::VARIABLE, {}, {} });
+    program.push({ Instruction::Type::NUMBER, {}, operand });
+    program.push({ Instruction::Type::OPERATOR, operation, {} });
+
+    return program;
+}
+
+Program& Program::then(Program const& next)
+{
+    push({ Instruction::Type::STORE_VARIABLE, {}, {} });
+
+    for (auto const& instruction : next.instructions_m)
+    {
+        [[maybe_unused]] auto const isValid = push(instruction);
+        assert(isValid && "CHAINED PROGRAM IS TOO DEEP");
+    }
+
+    return *this;
+}
+
+float Program::evaluate(float variable) const
+{
+    std::array<float, MAXIMUM_STACK_DEPTH> stack;
+    auto top = 0zu;
+
+    for (auto const& instruction : instructions_m)
+    {
+        switch (instruction.type)
+        {
+        case Instruction::Type::NUMBER: stack[top++] = instruction.number; break;
+        case Instruction::Type::VARIABLE: stack[top++] = variable; break;
+        case Instruction::Type::STORE_VARIABLE: variable = stack[--top]; break;
+        case Instruction::Type::OPERATOR: {
+            float lhs = stack[--top];
+            float& rhs = stack[top - 1];
+
+            switch (instruction.operation)
+            {
+            case '+': rhs += lhs; break;
+            case '-': rhs -= lhs; break;
+            case '*': rhs *= lhs; break;
+            case '/': rhs /= lhs; break;
+            case '^': rhs = std::pow(rhs, lhs); break;
+            }
+
+            break;
+        }
+        }
+    }
+
+    return stack[top - 1];
+}
+
+void Program::evaluate(std::span<float const> variables, std::span<float> results) const
+{
+    assert(variables.size() == results.size());
+
+    for (auto index = 0zu; index != variables.size(); index += 1)
+    {
+        results[index] = evaluate(variables[index]);
+    }
+}
+
+}
@@ -0,0 +1,59 @@
+#include "memory/AllocationCounter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> allocationCount {};
+
+void* allocate(std::size_t const size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    // ``malloc(0)`` may return a null pointer, which ``operator new`` isn't allowed to.
+    if (auto* const pointer = std::malloc(size == 0 ? 1 : size)) { return pointer; }
+
+    throw std::bad_alloc {};
+}
+
+void* allocate(std::size_t const size, std::align_val_t const alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    // ``aligned_alloc`` wants a size that is a multiple of the alignment, which is also never zero.
+    auto const alignmentInBytes = static_cast<std::size_t>(alignment);
+    auto const roundedSize      = (std::max(size, std::size_t { 1 }) + alignmentInBytes - 1) / alignmentInBytes * alignmentInBytes;
+
+    if (auto* const pointer = std::aligned_alloc(alignmentInBytes, roundedSize)) { return pointer; }
+
+    throw std::bad_alloc {};
+}
+
+}
+
+namespace ballin::memory {
+
+std::size_t allocation_count()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+}
+
+// the nothrow forms of the standard library end up in these, so replacing the plain and the over-aligned
+// ones is enough to see every allocation.
+void* operator new(std::size_t const size) { return allocate(size); }
+void* operator new[](std::size_t const size) { return allocate(size); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void* operator new(std::size_t const size, std::align_val_t const alignment) { return allocate(size, alignment); }
+void* operator new[](std::size_t const size, std::align_val_t const alignment) { return allocate(size, alignment); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
@@ -0,0 +1,29 @@
+#include "memory/LineArena.hpp"
+
+#include <utility>
+
+namespace ballin::memory {
+
+namespace {
+
+thread_local std::pmr::memory_resource* currentResource = nullptr;
+
+}
+
+std::pmr::memory_resource* line_resource()
+{
+    return currentResource != nullptr ? currentResource : std::pmr::new_delete_resource();
+}
+
+LineArena::LineArena(std::pmr::memory_resource* upstream):
+    pool_m(upstream),
+    previousResource_m(std::exchange(currentResource, &pool_m))
+{
+}
+
+LineArena::~LineArena()
+{
+    currentResource = previousResource_m;
+}
+
+}
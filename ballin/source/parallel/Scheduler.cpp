@@ -0,0 +1,234 @@
+#include "parallel/Scheduler.hpp"
+
+#include "io/Output.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace ballin::parallel {
+
+namespace {
+
+// index of the worker the calling thread is, if it is one, so tasks it spawns land on its own deque.
+thread_local Scheduler const* currentScheduler = nullptr;
+thread_local std::size_t currentWorkerIndex    = 0;
+
+constexpr std::size_t SPINS_BEFORE_PARKING = 64;
+
+std::mutex globalOptionsMutex {};
+std::optional<Scheduler::Options> globalOptions {};
+
+void pin_to_core(std::jthread& thread, std::size_t const core)
+{
+    cpu_set_t cpuSet {};
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core % std::max(1u, std::thread::hardware_concurrency()), &cpuSet);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet);
+}
+
+}
+
+Scheduler::Scheduler(Options const& options)
+{
+    auto const numberOfWorkers = std::max(options.numberOfWorkers, 1zu);
+
+    for (auto index = 0zu; index != numberOfWorkers; index += 1)
+    {
+        workers_m.push_back(std::make_unique<Worker>());
+    }
+
+    // the thread submitting work helps while it waits, so it counts as one of the workers.
+    for (auto index = 1zu; index != numberOfWorkers; index += 1)
+    {
+        threads_m.emplace_back([this, index] (std::stop_token const stopToken) { work(stopToken, index); });
+
+        if (options.pinWorkers) { pin_to_core(threads_m.back(), index); }
+    }
+}
+
+Scheduler::~Scheduler()
+{
+    for (auto& thread : threads_m) { thread.request_stop(); }
+
+    {
+        std::scoped_lock const lock { parkingMutex_m };
+        parkingCondition_m.notify_all();
+    }
+
+    threads_m.clear();
+}
+
+Scheduler::Options Scheduler::default_options()
+{
+    return { std::max(1u, std::thread::hardware_concurrency()), false };
+}
+
+void Scheduler::configure(Options const& options)
+{
+    std::scoped_lock const lock { globalOptionsMutex };
+    globalOptions = options;
+}
+
+Scheduler& Scheduler::global()
+{
+    static Scheduler scheduler { [] {
+        std::scoped_lock const lock { globalOptionsMutex };
+        return globalOptions.value_or(default_options());
+    }() };
+
+    return scheduler;
+}
+
+void Scheduler::submit(task_t task)
+{
+    auto const workerIndex = currentScheduler == this ? currentWorkerIndex : nextWorker_m++ % workers_m.size();
+
+    {
+        std::scoped_lock const lock { workers_m[workerIndex]->mutex };
+        workers_m[workerIndex]->tasks.push_back(std::move(task));
+    }
+
+    numberOfPendingTasks_m.fetch_add(1, std::memory_order_release);
+
+    std::scoped_lock const lock { parkingMutex_m };
+    parkingCondition_m.notify_one();
+}
+
+std::optional<Scheduler::task_t> Scheduler::take_task(std::size_t const workerIndex)
+{
+    if (numberOfPendingTasks_m.load(std::memory_order_acquire) == 0) { return std::nullopt; }
+
+    {
+        auto& worker = *workers_m[workerIndex];
+        std::scoped_lock const lock { worker.mutex };
+
+        if (!worker.tasks.empty())
+        {
+            auto task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            numberOfPendingTasks_m.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    for (auto offset = 1zu; offset != workers_m.size(); offset += 1)
+    {
+        auto& victim = *workers_m[(workerIndex + offset) % workers_m.size()];
+        std::scoped_lock const lock { victim.mutex };
+
+        if (!victim.tasks.empty())
+        {
+            auto task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            numberOfPendingTasks_m.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool Scheduler::run_pending_task()
+{
+    auto task = take_task(currentScheduler == this ? currentWorkerIndex : 0);
+
+    if (!task.has_value()) { return false; }
+
+    task.value()();
+
+    return true;
+}
+
+void Scheduler::work(std::stop_token const stopToken, std::size_t const workerIndex)
+{
+    currentScheduler   = this;
+    currentWorkerIndex = workerIndex;
+
+    while (!stopToken.stop_requested())
+    {
+        for (auto spin = 0zu; spin != SPINS_BEFORE_PARKING; spin += 1)
+        {
+            if (run_pending_task()) { spin = 0; }
+            if (stopToken.stop_requested()) { return; }
+        }
+
+        std::unique_lock lock { parkingMutex_m };
+        parkingCondition_m.wait(lock, stopToken, [this] { return numberOfPendingTasks_m.load(std::memory_order_acquire) != 0; });
+    }
+}
+
+TaskGroup::TaskGroup(Scheduler& scheduler):
+    scheduler_m(scheduler),
+    state_m(std::make_shared<State>())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait_for_tasks();
+}
+
+void TaskGroup::run(Scheduler::task_t task)
+{
+    state_m->numberOfRunningTasks.fetch_add(1, std::memory_order_relaxed);
+
+    // whatever the task prints goes where the thread that spawned it would have printed it.
+    scheduler_m.submit([state = state_m, task = std::move(task), destination = io::current_destination()] () mutable {
+        try
+        {
+            io::Adopt const adopt { destination };
+            task();
+        }
+        catch (...)
+        {
+            // the task is done all the same, ``wait`` rethrows it once the others are too.
+            std::scoped_lock const lock { state->mutex };
+            if (state->exception == nullptr) { state->exception = std::current_exception(); }
+        }
+
+        state->numberOfRunningTasks.fetch_sub(1, std::memory_order_release);
+        state->numberOfRunningTasks.notify_all();
+    });
+}
+
+void TaskGroup::wait()
+{
+    wait_for_tasks();
+
+    std::exception_ptr exception {};
+
+    {
+        std::scoped_lock const lock { state_m->mutex };
+        std::swap(exception, state_m->exception);
+    }
+
+    if (exception != nullptr) { std::rethrow_exception(exception); }
+}
+
+void TaskGroup::wait_for_tasks()
+{
+    for (auto spin = 0zu;; spin += 1)
+    {
+        auto const numberOfRunningTasks = state_m->numberOfRunningTasks.load(std::memory_order_acquire);
+
+        if (numberOfRunningTasks == 0) { return; }
+
+        if (scheduler_m.run_pending_task())
+        {
+            spin = 0;
+            continue;
+        }
+
+        if (spin < SPINS_BEFORE_PARKING)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // nothing is left to help with, the tasks of the group still running are on other threads and
+        // wake it once they are done.
+        state_m->numberOfRunningTasks.wait(numberOfRunningTasks, std::memory_order_acquire);
+    }
+}
+
+}
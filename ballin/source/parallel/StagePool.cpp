@@ -0,0 +1,98 @@
+#include "parallel/StagePool.hpp"
+
+#include "io/Output.hpp"
+
+namespace ballin::parallel {
+
+StagePool::~StagePool()
+{
+    for (auto& thread : threads_m) { thread.request_stop(); }
+
+    {
+        std::scoped_lock const lock { mutex_m };
+        condition_m.notify_all();
+    }
+
+    threads_m.clear();
+}
+
+StagePool& StagePool::global()
+{
+    static StagePool pool {};
+    return pool;
+}
+
+void StagePool::run(task_t task)
+{
+    std::scoped_lock const lock { mutex_m };
+
+    tasks_m.push_back(std::move(task));
+
+    // idle threads stop counting as such only once they took a task, so this also covers the ones
+    // already woken for a task pushed before.
+    if (tasks_m.size() > numberOfIdleThreads_m)
+    {
+        threads_m.emplace_back([this] (std::stop_token const stopToken) { work(stopToken); });
+        return;
+    }
+
+    condition_m.notify_one();
+}
+
+void StagePool::work(std::stop_token const stopToken)
+{
+    std::unique_lock lock { mutex_m };
+
+    while (true)
+    {
+        numberOfIdleThreads_m += 1;
+        condition_m.wait(lock, stopToken, [this] { return !tasks_m.empty(); });
+        numberOfIdleThreads_m -= 1;
+
+        if (tasks_m.empty()) { return; }
+
+        auto task = std::move(tasks_m.front());
+        tasks_m.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+StageGroup::StageGroup(StagePool& pool):
+    pool_m(pool),
+    numberOfRunningTasks_m(std::make_shared<std::atomic<std::size_t>>(0))
+{
+}
+
+StageGroup::~StageGroup()
+{
+    wait();
+}
+
+void StageGroup::run(StagePool::task_t task)
+{
+    numberOfRunningTasks_m->fetch_add(1, std::memory_order_relaxed);
+
+    // whatever the task prints goes where the thread that spawned it would have printed it.
+    pool_m.run([numberOfRunningTasks = numberOfRunningTasks_m, task = std::move(task), destination = io::current_destination()] () mutable {
+        {
+            io::Adopt const adopt { destination };
+            task();
+        }
+
+        numberOfRunningTasks->fetch_sub(1, std::memory_order_release);
+        numberOfRunningTasks->notify_all();
+    });
+}
+
+void StageGroup::wait()
+{
+    for (auto numberOfRunningTasks = numberOfRunningTasks_m->load(std::memory_order_acquire); numberOfRunningTasks != 0; numberOfRunningTasks = numberOfRunningTasks_m->load(std::memory_order_acquire))
+    {
+        numberOfRunningTasks_m->wait(numberOfRunningTasks, std::memory_order_acquire);
+    }
+}
+
+}
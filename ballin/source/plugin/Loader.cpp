@@ -0,0 +1,300 @@
+#include "plugin/Loader.hpp"
+
+#include "io/Output.hpp"
+#include "memory/LineArena.hpp"
+#include "plugin/Module.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ballin::plugin {
+
+namespace {
+
+using manifest_t = std::vector<std::pair<std::string, std::size_t>>;
+
+// the manifest of a module registered from it, checked against the table once the module gets loaded.
+struct Manifest
+{
+    manifest_t entries;
+    std::once_flag checked;
+};
+
+// a command of a module along with its entry in the table, looked up on first use and kept from then on.
+// it's shared by every copy of the command, so the lookup happens once however many lines use it.
+struct Binding
+{
+    std::shared_ptr<Module> module;
+    std::shared_ptr<Manifest> manifest;
+    std::string name;
+    std::size_t numberOfArguments;
+    std::atomic<ballin_command_entry const*> entry;
+};
+
+void report_mismatch(Module const& module, std::string_view const commandName, std::size_t const numberOfArguments, std::size_t const expectedNumberOfArguments)
+{
+    io::println("the manifest of `{}` says the command `{}` takes {} arguments, but the module expects {}.", module.path().string(), commandName, numberOfArguments, expectedNumberOfArguments);
+}
+
+// reports every command the manifest gets wrong about ``module``, loading it if that wasn't done yet.
+void check_manifest(Module& module, manifest_t const& manifest)
+{
+    auto const maybeTable = module.table();
+
+    if (!maybeTable.has_value())
+    {
+        io::println("{}", maybeTable.error());
+        return;
+    }
+
+    auto const commands = std::span { maybeTable.value()->commands, maybeTable.value()->numberOfCommands };
+
+    for (auto const& [commandName, numberOfArguments] : manifest)
+    {
+        auto const command = std::ranges::find_if(commands, [&] (auto&& entry) { return entry.name == commandName; });
+
+        if (command == commands.end())
+        {
+            io::println("the manifest of `{}` lists the command `{}`, which the module doesn't provide.", module.path().string(), commandName);
+        }
+        else if (command->expectedNumberOfArguments != numberOfArguments)
+        {
+            report_mismatch(module, commandName, numberOfArguments, command->expectedNumberOfArguments);
+        }
+    }
+}
+
+// there's no telling what a plugin does besides handing back values, so its commands never run alongside other lines.
+Command make_command(std::shared_ptr<Module> const& module, std::shared_ptr<Manifest> const& manifest, std::string_view const commandName, std::size_t const numberOfArguments, ballin_command_entry const* const entry = nullptr)
+{
+    auto binding = std::make_shared<Binding>(module, manifest, std::string { commandName }, numberOfArguments, entry);
+
+    return Command
+    {
+        commandName, numberOfArguments, [binding = std::move(binding)] (Command::arguments_t arguments) -> Command::return_t {
+            auto const* commandEntry = binding->entry.load(std::memory_order_acquire);
+
+            // lines running it at the same time may both look it up, they find the same entry.
+            if (commandEntry == nullptr)
+            {
+                auto isReported = false;
+
+                // the first command of the module to run checks the whole manifest, which covers this one as well.
+                if (binding->manifest != nullptr)
+                {
+                    std::call_once(binding->manifest->checked, [&] {
+                        check_manifest(*binding->module, binding->manifest->entries);
+                        isReported = true;
+                    });
+                }
+
+                auto const maybeEntry = binding->module->command(binding->name);
+
+                if (!maybeEntry.has_value())
+                {
+                    if (!isReported) { io::println("{}", maybeEntry.error()); }
+                    return {};
+                }
+
+                // the arguments were counted against the manifest, the module would be handed a number it doesn't expect.
+                if (maybeEntry.value()->expectedNumberOfArguments != binding->numberOfArguments)
+                {
+                    if (!isReported) { report_mismatch(*binding->module, binding->name, binding->numberOfArguments, maybeEntry.value()->expectedNumberOfArguments); }
+                    return {};
+                }
+
+                commandEntry = maybeEntry.value();
+                binding->entry.store(commandEntry, std::memory_order_release);
+            }
+
+            std::pmr::vector<ballin_string> rawArguments { memory::line_resource() };
+            rawArguments.reserve(arguments.size());
+
+            for (auto const& argument : arguments) { rawArguments.push_back({ argument.data(), argument.size() }); }
+
+            Command::return_t results { memory::line_resource() };
+
+            ballin_result_sink const sink {
+                &results, [] (void* context, char const* data, std::size_t size) {
+                    static_cast<Command::return_t*>(context)->emplace_back(data, size);
+                }
+            };
+
+            if (commandEntry->action(rawArguments.data(), rawArguments.size(), &sink) != 0)
+            {
+                io::println("the command `{}` failed.", binding->name);
+                return {};
+            }
+
+            return results;
+        }
+    }.with_effect(Command::Effect::BARRIER);
+}
+
+manifest_t read_manifest(std::filesystem::path const& path)
+{
+    manifest_t entries {};
+
+    std::ifstream manifest { path };
+
+    std::string commandName {};
+    std::size_t numberOfArguments {};
+
+    while (manifest >> commandName >> numberOfArguments)
+    {
+        entries.emplace_back(commandName, numberOfArguments);
+    }
+
+    return entries;
+}
+
+}
+
+Loader::Loader(Commands& commands):
+    commands_m(commands)
+{
+}
+
+std::expected<std::vector<Command>, std::string> Loader::make_commands(std::shared_ptr<Module> const& module) const
+{
+    std::vector<Command> moduleCommands {};
+
+    if (auto const manifest = std::filesystem::path { module->path() }.replace_extension(".manifest"); std::filesystem::exists(manifest))
+    {
+        auto const moduleManifest = std::make_shared<Manifest>(read_manifest(manifest));
+
+        for (auto const& [commandName, numberOfArguments] : moduleManifest->entries)
+        {
+            moduleCommands.push_back(make_command(module, moduleManifest, commandName, numberOfArguments));
+        }
+
+        return moduleCommands;
+    }
+
+    auto const maybeTable = module->table();
+
+    if (!maybeTable.has_value()) { return std::unexpected(maybeTable.error()); }
+
+    for (auto const& entry : std::span { maybeTable.value()->commands, maybeTable.value()->numberOfCommands })
+    {
+        moduleCommands.push_back(make_command(module, nullptr, entry.name, entry.expectedNumberOfArguments, &entry));
+    }
+
+    return moduleCommands;
+}
+
+void Loader::load_directory(std::filesystem::path const& directory)
+{
+    std::error_code error {};
+
+    if (!std::filesystem::is_directory(directory, error))
+    {
+        io::println("the plugin directory `{}` doesn't exist.", directory.string());
+        return;
+    }
+
+    auto paths = std::ranges::to<std::vector>(std::filesystem::directory_iterator { directory, error }
+        | std::views::transform([] (auto&& entry) { return entry.path(); })
+        | std::views::filter([] (auto&& path) { return path.extension() == ".so"; }));
+
+    std::ranges::sort(paths);
+
+    std::scoped_lock const lock { mutex_m };
+
+    std::vector<Command> pluginCommands {};
+
+    for (auto const& path : paths)
+    {
+        auto const moduleName = path.stem().string();
+
+        if (modules_m.contains(moduleName)) { continue; }
+
+        auto const maybeCommands = make_commands(std::make_shared<Module>(path));
+
+        if (!maybeCommands.has_value())
+        {
+            io::println("{}", maybeCommands.error());
+            continue;
+        }
+
+        auto& loadedModule = modules_m[moduleName];
+        loadedModule.path = path;
+
+        for (auto const& command : maybeCommands.value())
+        {
+            auto const isPending = std::ranges::find(pluginCommands, command.name(), &Command::name) != pluginCommands.end();
+
+            if (isPending || commands_m.contains(command.name()))
+            {
+                io::println("the command `{}` from `{}` is already registered, skipping it.", command.name(), path.string());
+                continue;
+            }
+
+            loadedModule.commandNames.push_back(command.name());
+            pluginCommands.push_back(command);
+        }
+    }
+
+    commands_m.register_commands(std::move(pluginCommands));
+}
+
+std::expected<std::size_t, std::string> Loader::reload(std::string_view const moduleName)
+{
+    std::scoped_lock const lock { mutex_m };
+
+    auto const loadedModule = modules_m.find(moduleName);
+
+    if (loadedModule == modules_m.end())
+    {
+        return std::unexpected(std::format("the module `{}` isn't loaded.", moduleName));
+    }
+
+    auto& [path, generation, commandNames] = loadedModule->second;
+
+    auto const module = std::make_shared<Module>(path, generation + 1);
+
+    // load eagerly, a broken build should leave the previous version in place.
+    if (auto const maybeTable = module->table(); !maybeTable.has_value())
+    {
+        return std::unexpected(maybeTable.error());
+    }
+
+    auto maybeCommands = make_commands(module);
+
+    if (!maybeCommands.has_value()) { return std::unexpected(maybeCommands.error()); }
+
+    auto const isOwnCommand = [&] (std::string_view const commandName) { return std::ranges::find(commandNames, commandName) != commandNames.end(); };
+
+    for (auto const& command : maybeCommands.value())
+    {
+        if (commands_m.contains(command.name()) && !isOwnCommand(command.name()))
+        {
+            return std::unexpected(std::format("the command `{}` from `{}` is already registered by another module.", command.name(), path.string()));
+        }
+    }
+
+    auto nextCommandNames = std::ranges::to<std::vector>(maybeCommands.value() | std::views::transform(&Command::name));
+
+    commands_m.replace_commands(commandNames, std::move(maybeCommands.value()));
+
+    generation  += 1;
+    commandNames = std::move(nextCommandNames);
+
+    return commandNames.size();
+}
+
+std::vector<std::string> Loader::module_names() const
+{
+    std::scoped_lock const lock { mutex_m };
+    return std::ranges::to<std::vector>(std::views::keys(modules_m));
+}
+
+}
@@ -0,0 +1,105 @@
+#include "plugin/Module.hpp"
+
+#include <algorithm>
+#include <format>
+#include <span>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+namespace ballin::plugin {
+
+Module::Module(std::filesystem::path const& path, std::size_t const generation):
+    path_m(path),
+    generation_m(generation)
+{
+}
+
+Module::~Module()
+{
+    if (handle_m != nullptr) { dlclose(handle_m); }
+}
+
+bool Module::is_loaded() const
+{
+    std::scoped_lock const lock { mutex_m };
+    return table_m != nullptr;
+}
+
+std::expected<ballin_plugin_table const*, std::string> Module::table()
+{
+    std::scoped_lock const lock { mutex_m };
+
+    if (table_m != nullptr) { return table_m; }
+
+    return load();
+}
+
+std::expected<ballin_command_entry const*, std::string> Module::command(std::string_view const commandName)
+{
+    auto const maybeTable = table();
+
+    if (!maybeTable.has_value()) { return std::unexpected(maybeTable.error()); }
+
+    auto const commands = std::span { maybeTable.value()->commands, maybeTable.value()->numberOfCommands };
+    auto const command  = std::ranges::find_if(commands, [&] (auto&& entry) { return entry.name == commandName; });
+
+    if (command == commands.end())
+    {
+        return std::unexpected(std::format("the module `{}` doesn't provide the command `{}`.", path_m.string(), commandName));
+    }
+
+    return &*command;
+}
+
+std::expected<ballin_plugin_table const*, std::string> Module::load()
+{
+    auto loadPath = path_m;
+
+    if (generation_m != 0)
+    {
+        loadPath = std::filesystem::temp_directory_path() / std::format("ballin-{}-{}-{}.so", getpid(), path_m.stem().string(), generation_m);
+
+        if (std::error_code error {}; !std::filesystem::copy_file(path_m, loadPath, std::filesystem::copy_options::overwrite_existing, error))
+        {
+            return std::unexpected(std::format("couldn't copy the module `{}`: {}", path_m.string(), error.message()));
+        }
+    }
+
+    auto* const handle = dlopen(loadPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+
+    // the mapping keeps the private copy alive, the file itself isn't needed anymore.
+    if (generation_m != 0)
+    {
+        std::error_code error {};
+        std::filesystem::remove(loadPath, error);
+    }
+
+    if (handle == nullptr)
+    {
+        return std::unexpected(std::format("couldn't load the module `{}`: {}", path_m.string(), dlerror()));
+    }
+
+    auto const entryPoint = reinterpret_cast<ballin_plugin_entry_point>(dlsym(handle, BALLIN_PLUGIN_ENTRY_POINT));
+
+    if (entryPoint == nullptr)
+    {
+        dlclose(handle);
+        return std::unexpected(std::format("the module `{}` doesn't export `{}`.", path_m.string(), BALLIN_PLUGIN_ENTRY_POINT));
+    }
+
+    auto const* const table = entryPoint();
+
+    if (table == nullptr || table->abiVersion != BALLIN_PLUGIN_ABI_VERSION)
+    {
+        dlclose(handle);
+        return std::unexpected(std::format("the module `{}` was built against an incompatible plugin ABI.", path_m.string()));
+    }
+
+    handle_m = handle;
+    table_m  = table;
+
+    return table_m;
+}
+
+}
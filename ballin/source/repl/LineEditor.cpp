@@ -0,0 +1,176 @@
+#include "repl/LineEditor.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iostream>
+#include <print>
+#include <ranges>
+
+#include <termios.h>
+#include <unistd.h>
+
+namespace ballin::repl {
+
+namespace {
+
+constexpr char KEY_END_OF_TRANSMISSION = 4;
+constexpr char KEY_BACKSPACE           = 8;
+constexpr char KEY_TAB                 = '\t';
+constexpr char KEY_ESCAPE              = 27;
+constexpr char KEY_DELETE              = 127;
+
+class RawModeGuard
+{
+public:
+    RawModeGuard()
+    {
+        tcgetattr(STDIN_FILENO, &original_m);
+
+        auto raw = original_m;
+        raw.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO);
+        raw.c_cc[VMIN]  = 1;
+        raw.c_cc[VTIME] = 0;
+
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
+    }
+
+    ~RawModeGuard() { tcsetattr(STDIN_FILENO, TCSAFLUSH, &original_m); }
+
+    RawModeGuard(RawModeGuard const&) = delete;
+    RawModeGuard& operator=(RawModeGuard const&) = delete;
+
+private:
+    termios original_m {};
+};
+
+std::optional<char> read_byte()
+{
+    char byte {};
+    if (::read(STDIN_FILENO, &byte, 1) != 1) { return std::nullopt; }
+    return byte;
+}
+
+}
+
+LineEditor::LineEditor(completer_t const completer):
+    completer_m(completer)
+{
+}
+
+std::optional<std::string_view> LineEditor::read_line(std::string_view const prompt)
+{
+    if (isatty(STDIN_FILENO) && completer_m)
+    {
+        return read_raw_line(prompt);
+    }
+
+    std::print("{}", prompt);
+    std::fflush(stdout);
+
+    if (!std::getline(std::cin, line_m)) { return std::nullopt; }
+
+    return line_m;
+}
+
+std::optional<std::string_view> LineEditor::read_raw_line(std::string_view const prompt)
+{
+    RawModeGuard const rawModeGuard {};
+
+    auto& line = line_m;
+    line.clear();
+
+    std::print("{}", prompt);
+    std::fflush(stdout);
+
+    while (true)
+    {
+        auto const maybeByte = read_byte();
+
+        if (!maybeByte.has_value()) { return std::nullopt; }
+
+        switch (auto const byte = maybeByte.value())
+        {
+        case '\r':
+        case '\n': {
+            std::print("\n");
+            return line;
+        }
+        case KEY_END_OF_TRANSMISSION: {
+            if (line.empty()) { return std::nullopt; }
+            break;
+        }
+        case KEY_BACKSPACE:
+        case KEY_DELETE: {
+            if (!line.empty())
+            {
+                line.pop_back();
+                std::print("\b \b");
+            }
+            break;
+        }
+        case KEY_TAB: {
+            complete_line(line, prompt);
+            break;
+        }
+        case KEY_ESCAPE: {
+            // swallow ``ESC [ x`` sequences (arrow keys and friends), they aren't supported.
+            if (read_byte() == '[') { read_byte(); }
+            break;
+        }
+        default: {
+            if (std::isprint(static_cast<unsigned char>(byte)))
+            {
+                line.push_back(byte);
+                std::print("{}", byte);
+            }
+        }
+        }
+
+        std::fflush(stdout);
+    }
+}
+
+void LineEditor::complete_line(std::string& line, std::string_view const prompt) const
+{
+    auto const completions = completer_m(line);
+
+    if (completions.empty())
+    {
+        std::print("\a");
+        return;
+    }
+
+    auto const wordStart = line.find_last_of(" |") == std::string::npos ? 0 : line.find_last_of(" |") + 1;
+    auto const word      = std::string_view { line }.substr(wordStart);
+
+    auto commonPrefix = std::string_view { completions.front() };
+
+    for (auto const& completion : completions | std::views::drop(1))
+    {
+        auto const prefixEnd = std::ranges::mismatch(commonPrefix, completion).in1;
+        commonPrefix = commonPrefix.substr(0, static_cast<std::size_t>(prefixEnd - commonPrefix.begin()));
+    }
+
+    if (commonPrefix.size() > word.size() || completions.size() == 1)
+    {
+        auto completion = std::string { commonPrefix.substr(word.size()) };
+        if (completions.size() == 1) { completion.push_back(' '); }
+
+        line += completion;
+        std::print("{}", completion);
+
+        return;
+    }
+
+    std::print("\n");
+
+    for (auto const& completion : completions)
+    {
+        std::print("{}  ", completion);
+    }
+
+    std::print("\n{}{}", prompt, line);
+}
+
+}
@@ -0,0 +1,86 @@
+#include "suggest/BKTree.hpp"
+
+#include "suggest/EditDistance.hpp"
+
+#include <algorithm>
+
+namespace ballin::suggest {
+
+void BKTree::insert(std::string_view const word)
+{
+    if (nodes_m.empty())
+    {
+        nodes_m.push_back({ std::string { word }, 0, {} });
+        return;
+    }
+
+    LevenshteinPattern const pattern { word };
+
+    auto current = 0zu;
+
+    while (true)
+    {
+        auto const distance = pattern.distance(nodes_m[current].word);
+
+        if (distance == 0) { return; }
+
+        auto& children = nodes_m[current].children;
+        auto const child = std::ranges::find(children, distance, [] (auto&& edge) { return edge.first; });
+
+        if (child == children.end())
+        {
+            nodes_m[current].maximumChildDistance = std::max(nodes_m[current].maximumChildDistance, distance);
+            children.emplace_back(distance, nodes_m.size());
+            nodes_m.push_back({ std::string { word }, 0, {} });
+            return;
+        }
+
+        current = child->second;
+    }
+}
+
+std::vector<BKTree::Match> BKTree::search(std::string_view const query, std::size_t const tolerance) const
+{
+    std::vector<Match> matches {};
+
+    if (nodes_m.empty()) { return matches; }
+
+    LevenshteinPattern const pattern { query };
+
+    std::vector<std::size_t> pending { 0 };
+
+    while (!pending.empty())
+    {
+        auto const& node = nodes_m[pending.back()];
+        pending.pop_back();
+
+        // past ``tolerance + maximumChildDistance`` neither this node nor any of its children can match,
+        // so the distance computation is allowed to bail out early.
+        auto const maybeDistance = pattern.distance(node.word, tolerance + node.maximumChildDistance);
+
+        if (!maybeDistance.has_value()) { continue; }
+
+        auto const distance = maybeDistance.value();
+
+        if (distance <= tolerance)
+        {
+            matches.push_back({ node.word, distance });
+        }
+
+        for (auto const& [childDistance, child] : node.children)
+        {
+            if (childDistance + tolerance >= distance && childDistance <= distance + tolerance)
+            {
+                pending.push_back(child);
+            }
+        }
+    }
+
+    std::ranges::sort(matches, [] (auto&& lhs, auto&& rhs) {
+        return lhs.distance != rhs.distance ? lhs.distance < rhs.distance : lhs.word < rhs.word;
+    });
+
+    return matches;
+}
+
+}
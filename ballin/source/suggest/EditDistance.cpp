@@ -0,0 +1,123 @@
+#include "suggest/EditDistance.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace ballin::suggest {
+
+namespace {
+
+constexpr std::size_t MACHINE_WORD_BITS = 64;
+
+constexpr auto absolute_difference(std::size_t lhs, std::size_t rhs) { return lhs > rhs ? lhs - rhs : rhs - lhs; }
+
+}
+
+LevenshteinPattern::LevenshteinPattern(std::string_view const pattern):
+    pattern_m(pattern)
+{
+    if (pattern_m.size() > MACHINE_WORD_BITS) { return; }
+
+    for (auto index = 0zu; index != pattern_m.size(); index += 1)
+    {
+        peq_m[static_cast<unsigned char>(pattern_m[index])] |= std::uint64_t { 1 } << index;
+    }
+}
+
+std::optional<std::size_t> LevenshteinPattern::distance(std::string_view const text, std::size_t const bound) const
+{
+    if (absolute_difference(pattern_m.size(), text.size()) > bound) { return std::nullopt; }
+
+    if (pattern_m.empty()) { return text.size(); }
+    if (text.empty()) { return pattern_m.size(); }
+
+    if (pattern_m.size() <= MACHINE_WORD_BITS)
+    {
+        return bit_parallel_distance(text, bound);
+    }
+
+    return table_distance(text, bound);
+}
+
+std::size_t LevenshteinPattern::distance(std::string_view const text) const
+{
+    return distance(text, std::max(pattern_m.size(), text.size())).value();
+}
+
+// Hyyrö's formulation of Myers' algorithm: the vertical deltas of a whole column of the
+// edit distance table are kept as two bit vectors and advanced one text byte at a time.
+std::optional<std::size_t> LevenshteinPattern::bit_parallel_distance(std::string_view const text, std::size_t const bound) const
+{
+    auto const lastBit = std::uint64_t { 1 } << (pattern_m.size() - 1);
+
+    std::uint64_t positiveVertical = ~std::uint64_t { 0 };
+    std::uint64_t negativeVertical = 0;
+    std::size_t score = pattern_m.size();
+
+    for (auto index = 0zu; index != text.size(); index += 1)
+    {
+        auto const equal = peq_m[static_cast<unsigned char>(text[index])];
+
+        auto const xVertical   = equal | negativeVertical;
+        auto const xHorizontal = (((equal & positiveVertical) + positiveVertical) ^ positiveVertical) | equal;
+
+        auto positiveHorizontal = negativeVertical | ~(xHorizontal | positiveVertical);
+        auto negativeHorizontal = positiveVertical & xHorizontal;
+
+        if (positiveHorizontal & lastBit) { score += 1; }
+        else if (negativeHorizontal & lastBit) { score -= 1; }
+
+        // every remaining byte of text can lower the score by at most one.
+        if (score > bound + (text.size() - index - 1)) { return std::nullopt; }
+
+        positiveHorizontal = (positiveHorizontal << 1) | 1;
+        negativeHorizontal = negativeHorizontal << 1;
+
+        positiveVertical = negativeHorizontal | ~(xVertical | positiveHorizontal);
+        negativeVertical = positiveHorizontal & xVertical;
+    }
+
+    if (score > bound) { return std::nullopt; }
+
+    return score;
+}
+
+std::optional<std::size_t> LevenshteinPattern::table_distance(std::string_view const text, std::size_t const bound) const
+{
+    std::vector<std::size_t> previousRow(pattern_m.size() + 1);
+    std::vector<std::size_t> currentRow(pattern_m.size() + 1);
+
+    std::iota(previousRow.begin(), previousRow.end(), 0zu);
+
+    for (auto row = 1zu; row <= text.size(); row += 1)
+    {
+        currentRow[0] = row;
+
+        for (auto column = 1zu; column <= pattern_m.size(); column += 1)
+        {
+            auto const substitution = previousRow[column - 1] + (text[row - 1] == pattern_m[column - 1] ? 0 : 1);
+            currentRow[column] = std::min({ previousRow[column] + 1, currentRow[column - 1] + 1, substitution });
+        }
+
+        if (std::ranges::min(currentRow) > bound) { return std::nullopt; }
+
+        std::swap(previousRow, currentRow);
+    }
+
+    if (previousRow.back() > bound) { return std::nullopt; }
+
+    return previousRow.back();
+}
+
+std::optional<std::size_t> calculate_edit_distance(std::string_view const from, std::string_view const to, std::size_t const bound)
+{
+    return LevenshteinPattern { from.size() <= to.size() ? from : to }.distance(from.size() <= to.size() ? to : from, bound);
+}
+
+std::size_t calculate_edit_distance(std::string_view const from, std::string_view const to)
+{
+    return calculate_edit_distance(from, to, std::max(from.size(), to.size())).value();
+}
+
+}
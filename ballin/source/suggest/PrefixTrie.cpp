@@ -0,0 +1,121 @@
+#include "suggest/PrefixTrie.hpp"
+
+#include <algorithm>
+
+namespace ballin::suggest {
+
+PrefixTrie::PrefixTrie():
+    nodes_m({ Node { {}, false, {} } })
+{
+}
+
+std::vector<std::size_t>::const_iterator PrefixTrie::find_child(std::size_t const node, char const byte) const
+{
+    auto const& children = nodes_m[node].children;
+
+    auto const child = std::ranges::lower_bound(children, byte, {}, [this] (auto&& index) { return nodes_m[index].label.front(); });
+
+    if (child != children.end() && nodes_m[*child].label.front() == byte) { return child; }
+
+    return children.end();
+}
+
+void PrefixTrie::insert(std::string_view const word)
+{
+    auto current = 0zu;
+    auto rest    = word;
+
+    while (!rest.empty())
+    {
+        auto const child = find_child(current, rest.front());
+
+        if (child == nodes_m[current].children.end())
+        {
+            auto& children = nodes_m[current].children;
+            auto const position = std::ranges::lower_bound(children, rest.front(), {}, [this] (auto&& index) { return nodes_m[index].label.front(); });
+            children.insert(position, nodes_m.size());
+            nodes_m.push_back({ std::string { rest }, false, {} });
+            current = nodes_m.size() - 1;
+            break;
+        }
+
+        auto const childIndex  = *child;
+        auto const& label      = nodes_m[childIndex].label;
+        auto const commonSize  = static_cast<std::size_t>(std::ranges::mismatch(label, rest).in1 - label.begin());
+
+        if (commonSize != label.size())
+        {
+            // split the edge so the shared part of the label becomes its own node.
+            auto const splitIndex = nodes_m.size();
+            nodes_m.push_back({ label.substr(0, commonSize), false, { childIndex } });
+            nodes_m[childIndex].label.erase(0, commonSize);
+
+            auto& children = nodes_m[current].children;
+            *std::ranges::find(children, childIndex) = splitIndex;
+
+            current = splitIndex;
+        }
+        else
+        {
+            current = childIndex;
+        }
+
+        rest.remove_prefix(commonSize);
+    }
+
+    if (!nodes_m[current].terminal)
+    {
+        nodes_m[current].terminal = true;
+        numberOfWords_m += 1;
+    }
+}
+
+std::vector<std::string> PrefixTrie::complete(std::string_view const prefix, std::size_t const limit) const
+{
+    std::vector<std::string> completions {};
+    std::string word {};
+
+    auto current = 0zu;
+    auto rest    = prefix;
+
+    while (!rest.empty())
+    {
+        auto const child = find_child(current, rest.front());
+
+        if (child == nodes_m[current].children.end()) { return completions; }
+
+        auto const& label = nodes_m[*child].label;
+
+        if (rest.size() <= label.size())
+        {
+            if (!label.starts_with(rest)) { return completions; }
+        }
+        else if (!rest.starts_with(label)) { return completions; }
+
+        word += label;
+        rest.remove_prefix(std::min(rest.size(), label.size()));
+        current = *child;
+    }
+
+    collect(current, word, completions, limit);
+
+    return completions;
+}
+
+void PrefixTrie::collect(std::size_t const node, std::string& word, std::vector<std::string>& completions, std::size_t const limit) const
+{
+    if (completions.size() == limit) { return; }
+
+    if (nodes_m[node].terminal) { completions.push_back(word); }
+
+    for (auto const child : nodes_m[node].children)
+    {
+        auto const labelSize = nodes_m[child].label.size();
+
+        word += nodes_m[child].label;
+        collect(child, word, completions, limit);
+        word.resize(word.size() - labelSize);
+    }
+}
+
+}